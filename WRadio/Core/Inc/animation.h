@@ -0,0 +1,51 @@
+/**
+******************************************************************************
+* @file           : animation.h
+* @brief          : shared animation timebase and phase accumulators
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_ANIMATION_H_
+#define INC_ANIMATION_H_
+
+#include <stdint.h>
+
+/* Effects advance in whole steps of their own period, counted on the
+ * microsecond clock instead of per rendered frame: a dropped frame is made up
+ * on the next one and the frame rate no longer sets the animation speed.
+ *
+ * Elapsed time is scaled by one global speed multiplier, 8.8 fixed point. */
+#define ANIMATION_SPEED_ONE       256         // 1.0x
+#define ANIMATION_SPEED_MIN       32          // 0.125x
+#define ANIMATION_SPEED_MAX       2048        // 8x
+#define ANIMATION_MAX_ELAPSED_US  1000000     // Longer gaps (debugger halt) are not made up
+
+/* Phase accumulator of one animation, in scaled microseconds (Q24.8).
+ * Step periods up to 4 s fit with a full catch-up at the top speed. */
+typedef struct {
+    uint32_t lastUs;        // Clock at the previous advance
+    uint32_t phase;         // Time into the current step
+    uint32_t stepLength;    // 0 = not animated
+} animation_phase_t;
+
+/* Function prototypes */
+void Animation_Start(animation_phase_t *anim, uint16_t stepMs);
+uint16_t Animation_Advance(animation_phase_t *anim);
+void Animation_SetSpeed(uint16_t speed);
+uint16_t Animation_GetSpeed(void);
+
+#endif /* INC_ANIMATION_H_ */
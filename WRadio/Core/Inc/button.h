@@ -0,0 +1,56 @@
+/**
+******************************************************************************
+* @file           : button.h
+* @brief          : interrupt-driven push button with timestamped edges
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_BUTTON_H_
+#define INC_BUTTON_H_
+
+#include "main.h"
+
+/* Button on PA0, active high. Edges are taken by EXTI and stamped with the
+ * TIM16 microsecond clock and posted as EVENT_BUTTON_EDGE, the main loop
+ * turns them into press events. */
+#define DEBOUNCE_TIME_MS        50      // Edges this soon after an accepted edge are contact bounce
+#define SHORT_PRESS_TIME_MS     DEBOUNCE_TIME_MS    // Every debounced press counts, a tap changes the effect
+#define LONG_PRESS_TIME_MS      1000    // 1 second for long press detection
+
+#define BUTTON_NO_DEADLINE      0xFFFFFFFF  // Button_TimeToNextEvent: nothing to time
+
+typedef enum {
+    BUTTON_EVENT_PRESS = 0,     // Button went down
+    BUTTON_EVENT_SHORT_RELEASE, // Released after SHORT_PRESS_TIME_MS .. LONG_PRESS_TIME_MS
+    BUTTON_EVENT_LONG_PRESS     // Held for LONG_PRESS_TIME_MS, fires while still held
+} button_event_type_t;
+
+typedef struct {
+    button_event_type_t type;
+    uint32_t durationUs;        // Time held, 0 for BUTTON_EVENT_PRESS
+    uint32_t timeUs;            // When it happened: the edge, or the long-press threshold
+} button_event_t;
+
+/* Function prototypes */
+void Button_Init(void);
+void Button_EXTI(void);
+uint8_t Button_HandleEdge(uint8_t pressed, uint32_t timeUs, button_event_t *event);
+uint8_t Button_Poll(button_event_t *event);
+uint8_t Button_IsHeld(void);
+uint32_t Button_TimeToNextEvent(void);
+
+#endif /* INC_BUTTON_H_ */
@@ -0,0 +1,51 @@
+/**
+******************************************************************************
+* @file           : event_queue.h
+* @brief          : lock-free queue of events from interrupts to the main loop
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_EVENT_QUEUE_H_
+#define INC_EVENT_QUEUE_H_
+
+#include "main.h"
+
+/* Single producer, single consumer. All interrupts that post run at the same
+ * NVIC priority, so they never preempt each other and together count as the
+ * one producer. Thread code may only post with interrupts masked. */
+#define EVENT_QUEUE_SIZE    8   // Power of 2
+
+typedef enum {
+    EVENT_BUTTON_EDGE = 0,      // arg: 1 = pressed, 0 = released (debounced)
+    EVENT_FRAME_DONE,           // A frame finished on the wire
+    EVENT_FRAME_DEADLINE        // The scheduler's next frame slot has started
+} event_type_t;
+
+typedef struct {
+    uint32_t timeUs;            // Frame_Scheduler_Micros() when it happened
+    uint8_t type;               // event_type_t
+    uint8_t arg;
+} event_t;
+
+/* Function prototypes */
+uint8_t Event_Queue_Post(event_type_t type, uint8_t arg, uint32_t timeUs);
+uint8_t Event_Queue_Get(event_t *event);
+uint8_t Event_Queue_IsEmpty(void);
+uint8_t Event_Queue_GetHighWater(void);
+uint32_t Event_Queue_GetOverflows(void);
+
+#endif /* INC_EVENT_QUEUE_H_ */
@@ -0,0 +1,46 @@
+/**
+******************************************************************************
+* @file           : fixed_math.h
+* @brief          : division-free fixed-point helpers for colour and brightness math
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_FIXED_MATH_H_
+#define INC_FIXED_MATH_H_
+
+#include <stdint.h>
+
+/* The Cortex-M0 has no divider and no FPU: everything here is integer
+ * multiply and shift so no __aeabi_*div or soft-float helpers get linked.
+ *
+ * Scale8 values are fractions of 255 (255 = 1.0), Q16 values are 16.16.
+ * Use the macros for constants only, they fold at compile time. */
+#define FIXED_SCALE8(f)   ((uint8_t)((f) * 255.0 + 0.5))
+#define FIXED_Q16(f)      ((q16_t)((f) * 65536.0))
+#define FIXED_Q16_ONE     ((q16_t)0x10000)
+
+typedef int32_t q16_t;
+
+/* Function prototypes */
+uint8_t Fixed_Math_Scale8(uint8_t x, uint8_t scale);
+uint8_t Fixed_Math_Percent8(uint8_t x, uint8_t percent);
+uint8_t Fixed_Math_Lerp8(uint8_t from, uint8_t to, uint8_t frac);
+uint32_t Fixed_Math_ScaleColor(uint32_t color, uint8_t scale);
+uint32_t Fixed_Math_LerpColor(uint32_t from, uint32_t to, uint8_t frac);
+q16_t Fixed_Math_MulQ16(q16_t a, q16_t b);
+
+#endif /* INC_FIXED_MATH_H_ */
@@ -27,22 +27,58 @@
 
 /* Flash storage configuration */
 #define FLASH_STORAGE_PAGE_ADDR   0x08003C00  // Last 1KB of 16KB flash
-#define FLASH_STORAGE_MAGIC       0xDEADBEEF  // Magic number to verify valid data
+#define FLASH_STORAGE_PAGE_SIZE   0x400
+#define FLASH_STORAGE_RECORD_MAGIC 0x5E7C     // Header of a CRC-checked record
 
-/* Storage structure */
+/* Versions of the stored layout. 1 and 2 were written by older firmware
+ * and are only read, to carry users' settings over. */
+#define FLASH_SETTINGS_VERSION_SINGLE  1      // One record at the page start, XOR checksum
+#define FLASH_SETTINGS_VERSION_LOG     2      // 16-byte log record, XOR checksum
+#define FLASH_SETTINGS_VERSION         3      // flash_settings_t behind a header, hardware CRC
+
+/* Settings as the firmware uses them, read from flash once at boot and
+ * served from RAM. To add a field (effect speed, custom colours, ...):
+ * append it, bump FLASH_SETTINGS_VERSION, give it a default in
+ * Flash_Storage_Defaults and add a case for the new version in
+ * Flash_Storage_Decode. Older, shorter records keep the fields they have
+ * and the new ones start at their defaults. */
 typedef struct {
-    uint32_t magic;           // Magic number for validation
-    effect_mode_t mode;       // Current effect mode
+    uint8_t mode;             // Current effect mode
     uint8_t brightnessLevel;  // Brightness level index (0-4)
-    uint8_t reserved[6];      // Reserved for future use
-    uint32_t checksum;        // Simple checksum
+    uint8_t reserved[2];      // Keeps the payload a whole number of words
 } flash_settings_t;
 
+/* The page is a log: every save appends a record after the last one and the
+ * valid record with the highest sequence number is the current one. The
+ * page is only erased when the next record no longer fits. A record is the
+ * header, the flash_settings_t payload and a CRC-32 over both, written in
+ * that order so a torn record never passes its CRC. */
+typedef struct {
+    uint16_t magic;           // FLASH_STORAGE_RECORD_MAGIC
+    uint8_t version;          // Layout of the payload
+    uint8_t words;            // Whole record in words, header and CRC included
+    uint32_t sequence;        // Save counter, carried across erases
+    uint16_t eraseCount;      // Page erases so far, carried from record to record
+    uint16_t reserved;
+} flash_record_header_t;
+
+/* Saves are written in steps that each fit a gap between frames */
+#define FLASH_STORAGE_ERASE_US     40000   // Worst-case page erase (tERASE max)
+#define FLASH_STORAGE_PROGRAM_US   200     // One word, two halfword programs, with margin
+#define FLASH_STORAGE_MAX_DEFER_MS 10000   // An erase holding up a save is forced after this
+
 /* Function prototypes */
 void Flash_Storage_Init(void);
+const flash_settings_t* Flash_Storage_GetSettings(void);
 effect_mode_t Flash_Storage_ReadMode(void);
 uint8_t Flash_Storage_ReadBrightnessLevel(void);
-HAL_StatusTypeDef Flash_Storage_SaveSettings(effect_mode_t mode, uint8_t brightnessLevel);
-uint32_t Flash_Storage_CalculateChecksum(flash_settings_t* settings);
+void Flash_Storage_RequestSave(effect_mode_t mode, uint8_t brightnessLevel);
+HAL_StatusTypeDef Flash_Storage_Step(uint32_t gapUs);
+uint8_t Flash_Storage_HasWork(void);
+uint16_t Flash_Storage_GetEraseCount(void);
+uint32_t Flash_Storage_GetLongestStall(void);
+uint32_t Flash_Storage_GetTotalStall(void);
+uint32_t Flash_Storage_GetSaveCount(void);
+uint32_t Flash_Storage_Crc(const uint32_t* data, uint32_t words);
 
 #endif /* INC_FLASH_STORAGE_H_ */
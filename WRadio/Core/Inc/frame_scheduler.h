@@ -0,0 +1,58 @@
+/**
+******************************************************************************
+* @file           : frame_scheduler.h
+* @brief          : hardware-timed frame clock with jitter statistics
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_FRAME_SCHEDULER_H_
+#define INC_FRAME_SCHEDULER_H_
+
+#include "main.h"
+
+/* TIM16 free-runs at 1 MHz and its compare wakes the core on each frame deadline
+ * and at the end of each Low_Power sleep */
+#define FRAME_SCHEDULER_NO_DEADLINE 0xFFFFFFFF  // Frame_Scheduler_TimeToNextFrame: no frame clock running
+
+/* Frame timing of the running effect, reset whenever the period changes */
+typedef struct {
+    uint32_t periodUs;        // Requested frame period
+    uint32_t frames;          // Frames dispatched
+    uint32_t intervalMinUs;   // Shortest time between two frame starts
+    uint32_t intervalMaxUs;   // Longest time between two frame starts
+    uint32_t intervalMeanUs;  // Running average, each frame weighs 1/16
+    uint32_t renderMaxUs;     // Longest render plus encode
+    uint32_t renderMeanUs;    // Running average, each frame weighs 1/16
+    uint32_t overruns;        // Frames whose render took longer than the period
+    uint32_t framesSkipped;   // Frame slots dropped to get back on schedule
+} frame_scheduler_stats_t;
+
+/* Function prototypes */
+void Frame_Scheduler_Init(void);
+void Frame_Scheduler_Start(uint32_t periodUs);
+uint8_t Frame_Scheduler_FrameDue(void);
+void Frame_Scheduler_FrameRendered(void);
+uint32_t Frame_Scheduler_TimeToNextFrame(void);
+uint32_t Frame_Scheduler_TimeToNextFrameUs(void);
+uint32_t Frame_Scheduler_Micros(void);
+void Frame_Scheduler_SetWakeup(uint32_t timeUs);
+void Frame_Scheduler_ClearWakeup(void);
+void Frame_Scheduler_TIM_Overflow(void);
+void Frame_Scheduler_TIM_Deadline(void);
+const frame_scheduler_stats_t* Frame_Scheduler_GetStats(void);
+
+#endif /* INC_FRAME_SCHEDULER_H_ */
@@ -0,0 +1,43 @@
+/**
+******************************************************************************
+* @file           : low_power.h
+* @brief          : tickless sleep between frames and stop mode while the logo is static
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_LOW_POWER_H_
+#define INC_LOW_POWER_H_
+
+#include "main.h"
+
+/* Sleeps are timed on the TIM16 microsecond clock, its compare wakes the core */
+#define LOW_POWER_MAX_SLEEP_MS  60  // Longest single sleep, TIM16 overflows every 65.5 ms anyway
+
+/* Time spent awake and asleep since boot. The counts wrap after 71 minutes,
+ * take differences over a window. */
+typedef struct {
+    uint32_t activeUs;   // Core running
+    uint32_t sleepUs;    // Core in WFI with SysTick suspended
+    uint32_t stopCount;  // Times the core entered Stop mode (not timed, TIM16 stops too)
+} low_power_stats_t;
+
+/* Function prototypes */
+void Low_Power_Init(void);
+void Low_Power_Idle(uint32_t timeoutMs, uint8_t allowStop);
+const low_power_stats_t* Low_Power_GetStats(void);
+
+#endif /* INC_LOW_POWER_H_ */
@@ -0,0 +1,42 @@
+/**
+******************************************************************************
+* @file           : lut.h
+* @brief          : flash lookup tables for sine, gamma and hue
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_LUT_H_
+#define INC_LUT_H_
+
+#include <stdint.h>
+
+/* Const tables in flash, generated by Host/lut_gen.py into lut_tables.c.
+ * The sine and hue tables hold one segment and are mirrored here, so the
+ * three together cost 407 bytes of flash and no RAM. */
+#define LUT_SIN8_QUARTER    64      // lutSin8Quarter: 65 bytes
+#define LUT_HUE_SECTOR      85      // lutHue8Ramp: 86 bytes, lutGamma8: 256 bytes
+
+extern const uint8_t lutSin8Quarter[LUT_SIN8_QUARTER + 1];
+extern const uint8_t lutGamma8[256];
+extern const uint8_t lutHue8Ramp[LUT_HUE_SECTOR + 1];
+
+/* Function prototypes */
+uint8_t Lut_Sin8(uint8_t theta);
+uint8_t Lut_Gamma8(uint8_t x);
+uint32_t Lut_Hue8(uint8_t hue);
+
+#endif /* INC_LUT_H_ */
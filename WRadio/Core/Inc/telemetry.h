@@ -0,0 +1,93 @@
+/**
+******************************************************************************
+* @file           : telemetry.h
+* @brief          : performance counters at a fixed RAM address, read over SWD
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#include "main.h"
+#include "ws2812b.h"
+
+/* The block sits at the start of RAM (.telemetry in the linker script) so a
+ * debugger can read it over SWD while the core runs, decode a dump of it
+ * with Host/telemetry.py. Times come from the TIM16 microsecond clock.
+ * Off by default: the block and its bookkeeping take about 260 bytes of
+ * the 4 KB of RAM, build with TELEMETRY_ENABLED=1 to look at a unit. */
+#ifndef TELEMETRY_ENABLED
+#define TELEMETRY_ENABLED           0           // 1 = keep the block, 0 = the hooks compile to nothing
+#endif
+#define TELEMETRY_ADDRESS           0x20000000  // Where the linker script puts the block
+#define TELEMETRY_MAGIC             0x4D4C5457  // "WTLM"
+#define TELEMETRY_VERSION           2           // Bump with any change of telemetry_t
+#define TELEMETRY_LOAD_WINDOW_MS    1000        // CPU load is measured over windows this long
+
+/* Per effect times in microseconds, means weigh each frame 1/16 */
+typedef struct {
+    uint16_t renderMaxUs;       // Frame start to submit: the effect itself
+    uint16_t renderMeanUs;
+    uint16_t encodeMaxUs;       // WS2812B_PrepareBuffer
+    uint16_t encodeMeanUs;
+    uint16_t dmaMaxUs;          // DMA start to frame done, reset included
+    uint16_t dmaMeanUs;
+    uint16_t inputMaxUs;        // Button event (PA0 edge or long-press threshold) to the DMA start of
+                                // the first frame showing it, in the effect switched to
+} telemetry_effect_t;
+
+/* Read it whole and compare sequence before and after: an odd or changed
+ * sequence means an update was in progress, read again */
+typedef struct {
+    uint32_t magic;             // TELEMETRY_MAGIC
+    uint16_t version;           // TELEMETRY_VERSION
+    uint16_t size;              // sizeof(telemetry_t)
+    uint32_t sequence;          // Odd while the main loop updates the block
+    uint32_t uptimeMs;          // HAL tick, Stop mode not counted
+    uint8_t mode;               // Effect running
+    uint8_t reserved;
+    uint16_t cpuLoadPermille;   // Active share of the last load window, Stop mode not counted
+    uint16_t cpuLoadMaxPermille;
+    uint16_t reserved2;
+    uint32_t framesRendered;    // Frames the effects submitted
+    uint32_t framesSent;        // Frames fully clocked out
+    uint32_t framesSkipped;     // Submits with nothing changed
+    uint32_t framesDropped;     // Submits while a frame was still going out
+    uint32_t timeouts;          // WS2812B_SendToLEDs frames aborted after WS2812B_TIMEOUT_MS
+    uint32_t flashSaves;        // Settings records written
+    uint32_t flashErases;       // Page erases since the page was first written
+    uint32_t flashStallMaxUs;   // Longest single erase or program
+    uint32_t flashStallTotalUs; // All time the flash kept the core off its code
+    telemetry_effect_t effects[MODE_COUNT];
+} telemetry_t;
+
+#if TELEMETRY_ENABLED
+extern telemetry_t telemetry;
+#endif
+
+/* Function prototypes */
+void Telemetry_Init(void);
+void Telemetry_FrameStart(effect_mode_t mode);
+void Telemetry_FrameWaited(uint32_t since);
+void Telemetry_FrameSubmitted(void);
+void Telemetry_FrameEncoded(void);
+void Telemetry_FrameSkipped(void);
+void Telemetry_FrameSent(void);
+void Telemetry_InputEvent(uint32_t timeUs);
+void Telemetry_Update(effect_mode_t mode);
+
+#endif /* INC_TELEMETRY_H_ */
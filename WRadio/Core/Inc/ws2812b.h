@@ -23,11 +23,40 @@
 
 #include "main.h"
 
-/* User configuration */
+/* User configuration, LED_COUNT can be overridden from the command line (Host bench) */
+#ifndef LED_COUNT
 #define LED_COUNT	76 //76 WRADIO
+#endif
 #define WS2812B_RESET_LEN   50
 #define WS2812B_BUFFER_SIZE (LED_COUNT * 24 + WS2812B_RESET_LEN)
 
+/* Streaming transport: instead of encoding the whole chain into ledBuffer,
+ * DMA1_Channel4 runs circular over a ring of WS2812B_RING_LEDS pixels and the
+ * half/full transfer interrupts encode the next pixels just in time.
+ * RAM use no longer depends on LED_COUNT. */
+#ifndef WS2812B_STREAMING
+#define WS2812B_STREAMING   0   // 1 = stream through the DMA ring, 0 = full frame buffer
+#endif
+#define WS2812B_RING_LEDS   4   // Must be even, each half holds RING_LEDS / 2 pixels
+#define WS2812B_RING_SIZE   (WS2812B_RING_LEDS * 24)
+#define WS2812B_LATCH_CYCLES (WS2812B_RESET_LEN * 60)  // Reset time in TIM3 clocks (62.5us)
+
+#define WS2812B_TIMEOUT_MS  100 // A frame still busy after this is aborted
+
+/* Temporal dithering: the fraction lost when brightness scales a channel down
+ * to 8 bits is carried to the pixel's next frame, so dim fades move in
+ * sub-steps instead of stair-stepping. Costs 3 bytes of RAM per LED, and
+ * every frame is encoded in full and sent at least every DITHER_PERIOD_MS,
+ * the static logo too. */
+#ifndef WS2812B_DITHER
+#define WS2812B_DITHER      0   // 1 = dither the encoder output
+#endif
+#define WS2812B_DITHER_PERIOD_MS 10 // Slowest frame rate while dithering, 100 Hz
+
+#ifndef WS2812B_BENCHMARK
+#define WS2812B_BENCHMARK   0   // 1 = record worst-case cycles per effect step
+#endif
+
 /* WR Logo pixel ranges */
 #define W_START    0
 #define W_END      20
@@ -57,17 +86,64 @@ typedef struct {
     uint8_t blue;
 } LED_Color;
 
+/* One entry of the effect registry in ws2812b.c */
+typedef struct {
+    void (*init)(void);     // Sets up the effect's state, NULL if all zero will do
+    void (*render)(void);   // Draws and sends one frame
+    uint16_t stepMs;        // Animation step and default frame period, 0 = only redrawn when something changes
+} ws2812b_effect_t;
+
+/* Brightness segments, scaled on top of globalBrightness at encode time */
+typedef enum {
+    WS2812B_SEGMENT_W = 0,      // W_START .. R_START - 1
+    WS2812B_SEGMENT_R,          // R_START .. R_END
+    WS2812B_SEGMENT_BACKGROUND, // R_END + 1 .. LED_COUNT - 1
+    WS2812B_SEGMENT_COUNT
+} ws2812b_segment_t;
+
+/* Transport state */
+typedef enum {
+    WS2812B_READY = 0,
+    WS2812B_BUSY
+} ws2812b_state_t;
+
+typedef void (*ws2812b_frame_done_cb_t)(void);
+
+typedef struct {
+    uint32_t framesSent;     // Frames fully clocked out including the reset
+    uint32_t framesDropped;  // Submits rejected because a frame was still going out
+    uint32_t timeouts;       // Frames aborted after WS2812B_TIMEOUT_MS
+    uint32_t framesSkipped;  // Submits with no changed pixel and no brightness change
+    uint32_t pixelsEncoded;  // Pixels re-encoded into the DMA buffer
+} ws2812b_transport_stats_t;
+
+/* Streaming transport statistics (cycles are HCLK cycles at 48 MHz) */
+typedef struct {
+    uint32_t refillMaxCycles;      // Worst-case refill time measured in the DMA ISR
+    uint32_t refillDeadlineCycles; // Time the DMA needs to drain one ring half
+    uint32_t underruns;            // Refills that finished after the DMA caught up
+} ws2812b_stream_stats_t;
+
 extern uint8_t globalBrightness;
 extern uint8_t baseBrightness;
 
 /* Function prototypes */
 void WS2812B_Init(void);
+void WS2812B_SetPixel(uint16_t index, uint32_t color);
 void WS2812B_SetLED(uint16_t index, uint8_t red, uint8_t green, uint8_t blue);
 void WS2812B_SetAllLED(uint8_t red, uint8_t green, uint8_t blue);
 void WS2812B_Clear(void);
 void WS2812B_PrepareBuffer(void);
 void WS2812B_SendToLEDs(void);
+HAL_StatusTypeDef WS2812B_SubmitFrame(void);
+ws2812b_state_t WS2812B_Poll(void);
+uint8_t WS2812B_IsBusy(void);
+void WS2812B_SetFrameDoneCallback(ws2812b_frame_done_cb_t callback);
+const ws2812b_transport_stats_t* WS2812B_GetTransportStats(void);
 void WS2812B_TIM_DMADelayPulseFinished(void);
+void WS2812B_TIM_DMADelayPulseHalfFinished(void);
+void WS2812B_TIM_LatchElapsed(void);
+const ws2812b_stream_stats_t* WS2812B_GetStreamStats(void);
 
 /* Logo and effect functions */
 void WS2812B_SetLogoColors(void);
@@ -82,12 +158,17 @@ void WS2812B_FillEffect(void);
 void WS2812B_ScannerEffect(void);
 void WS2812B_ColorShiftEffect(void);
 void WS2812B_StrobeEffect(void);
-uint32_t WS2812B_Wheel(uint8_t wheelPos);
 void WS2812B_RunEffect(effect_mode_t mode);
 
 /* Utility functions */
 uint32_t ws_random_byte(uint32_t max);
 uint32_t WS2812B_Color(uint8_t r, uint8_t g, uint8_t b);
-void WS2812B_TriggerStaticLogoUpdate(void);
+void WS2812B_SetSegmentBrightness(ws2812b_segment_t segment, uint8_t brightness);
+void WS2812B_RefreshEffect(void);
+void WS2812B_SetFramePeriod(uint16_t periodMs);
+#if WS2812B_BENCHMARK
+uint32_t WS2812B_GetEffectCycles(effect_mode_t mode);
+uint8_t WS2812B_BenchmarkEncoder(uint32_t *loopCyclesPerLed, uint32_t *lutCyclesPerLed);
+#endif
 
 #endif
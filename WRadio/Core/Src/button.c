@@ -0,0 +1,158 @@
+/**
+******************************************************************************
+* @file           : button.c
+* @brief          : interrupt-driven push button with timestamped edges
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "button.h"
+#include "event_queue.h"
+#include "frame_scheduler.h"
+
+#define DEBOUNCE_TIME_US    (DEBOUNCE_TIME_MS * 1000UL)
+
+/* Debounce state, owned by the EXTI interrupt */
+static volatile uint8_t acceptedLevel = 0;      // Debounced pin level
+static volatile uint32_t acceptedTimeUs = 0;    // When that level was taken
+
+/* Press tracking, owned by the main loop */
+static uint8_t held = 0;
+static uint8_t longPressSent = 0;
+static uint32_t pressTimeUs = 0;
+
+static uint8_t Button_ReadPin(void)
+{
+    return HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_0) == GPIO_PIN_SET;
+}
+
+/* Take a new debounced level. Called from the interrupt or with it masked. */
+static void Button_Accept(uint8_t level, uint32_t now)
+{
+    acceptedLevel = level;
+    acceptedTimeUs = now;
+    Event_Queue_Post(EVENT_BUTTON_EDGE, level, now);
+}
+
+void Button_Init(void)
+{
+    acceptedLevel = Button_ReadPin();
+    acceptedTimeUs = Frame_Scheduler_Micros() - DEBOUNCE_TIME_US;
+    held = acceptedLevel;
+    longPressSent = 1;      // Held at power-up: wait for a fresh press
+}
+
+/* EXTI callback for PA0. The first edge after a quiet period is the real
+ * one and keeps its timestamp, the bounce that follows is ignored. */
+void Button_EXTI(void)
+{
+    uint32_t now = Frame_Scheduler_Micros();
+    uint8_t level = Button_ReadPin();
+
+    if (level == acceptedLevel) return;
+    if (now - acceptedTimeUs < DEBOUNCE_TIME_US) return;
+
+    Button_Accept(level, now);
+}
+
+/* Turn an EVENT_BUTTON_EDGE into a button event. Returns 1 if it made one. */
+uint8_t Button_HandleEdge(uint8_t pressed, uint32_t timeUs, button_event_t *event)
+{
+    if (pressed) {
+        held = 1;
+        longPressSent = 0;
+        pressTimeUs = timeUs;
+        event->type = BUTTON_EVENT_PRESS;
+        event->durationUs = 0;
+        event->timeUs = timeUs;
+        return 1;
+    }
+
+    if (!held) return 0;
+    held = 0;
+
+    uint32_t duration = timeUs - pressTimeUs;
+    if (longPressSent || duration < SHORT_PRESS_TIME_MS * 1000UL) return 0;
+
+    // A long press the main loop was too busy to see while it was held
+    event->type = (duration >= LONG_PRESS_TIME_MS * 1000UL) ? BUTTON_EVENT_LONG_PRESS
+                                                             : BUTTON_EVENT_SHORT_RELEASE;
+    event->durationUs = duration;
+    event->timeUs = timeUs;
+    return 1;
+}
+
+/* Main-loop housekeeping: an edge hidden by the debounce window and the
+ * long-press threshold. Returns 1 if it made an event. */
+uint8_t Button_Poll(button_event_t *event)
+{
+    // A level change that fell inside the debounce window has no edge left
+    // to report it, pick it up once the window has closed
+    __disable_irq();
+    uint32_t now = Frame_Scheduler_Micros();
+    uint8_t level = Button_ReadPin();
+    if (level != acceptedLevel && now - acceptedTimeUs >= DEBOUNCE_TIME_US) {
+        Button_Accept(level, now);
+    }
+    __enable_irq();
+
+    if (held && !longPressSent) {
+        uint32_t duration = now - pressTimeUs;
+        if (duration >= LONG_PRESS_TIME_MS * 1000UL) {
+            longPressSent = 1;
+            event->type = BUTTON_EVENT_LONG_PRESS;
+            event->durationUs = duration;
+            event->timeUs = pressTimeUs + LONG_PRESS_TIME_MS * 1000UL;
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* Down, so the long-press threshold still needs the microsecond clock */
+uint8_t Button_IsHeld(void)
+{
+    return held || acceptedLevel;
+}
+
+/* Milliseconds until Button_Poll has something new without another edge:
+ * the long-press threshold or the end of the debounce window. An open window
+ * always counts, even with no edge hidden in it: TIM16 stops in Stop mode,
+ * so a window still open when the core stops would stay open after it wakes
+ * and swallow the first press. */
+uint32_t Button_TimeToNextEvent(void)
+{
+    uint32_t now = Frame_Scheduler_Micros();
+    uint32_t untilUs = BUTTON_NO_DEADLINE;
+    uint32_t elapsed = now - acceptedTimeUs;
+
+    if (elapsed < DEBOUNCE_TIME_US) {
+        untilUs = DEBOUNCE_TIME_US - elapsed;
+    } else if (Button_ReadPin() != acceptedLevel) {
+        untilUs = 0;
+    }
+
+    if (held && !longPressSent) {
+        uint32_t elapsed = now - pressTimeUs;
+        uint32_t untilLong = (elapsed >= LONG_PRESS_TIME_MS * 1000UL) ? 0 : LONG_PRESS_TIME_MS * 1000UL - elapsed;
+        if (untilLong < untilUs) untilUs = untilLong;
+    }
+
+    if (untilUs == BUTTON_NO_DEADLINE) return BUTTON_NO_DEADLINE;
+
+    // Round up with a multiply instead of a divide: 1/1000 ~= 1049 / 2^20
+    return ((untilUs * 1049) >> 20) + 1;
+}
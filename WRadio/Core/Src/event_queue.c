@@ -0,0 +1,87 @@
+/**
+******************************************************************************
+* @file           : event_queue.c
+* @brief          : lock-free queue of events from interrupts to the main loop
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "event_queue.h"
+
+/* Cortex-M0 has no LDREX/STREX, so nothing here is read-modify-write on
+ * shared data: head is only written by the producer, tail only by the
+ * consumer, and single byte stores are atomic. The barriers keep the
+ * compiler from moving the slot access across the index update. */
+static event_t events[EVENT_QUEUE_SIZE];
+static volatile uint8_t head = 0;
+static volatile uint8_t tail = 0;
+static uint8_t highWater = 0;       // Most events ever waiting at once
+static uint32_t overflows = 0;      // Events lost to a full queue
+
+/* Producer side, from interrupt context. Returns 0 if the queue was full. */
+uint8_t Event_Queue_Post(event_type_t type, uint8_t arg, uint32_t timeUs)
+{
+    uint8_t h = head;
+    uint8_t used = (uint8_t)(h - tail);
+
+    if (used >= EVENT_QUEUE_SIZE) {
+        overflows++;
+        return 0;
+    }
+
+    event_t *event = &events[h & (EVENT_QUEUE_SIZE - 1)];
+    event->timeUs = timeUs;
+    event->type = type;
+    event->arg = arg;
+
+    __DMB();        // Slot written before it is published
+    head = h + 1;
+
+    if (used + 1 > highWater) {
+        highWater = used + 1;
+    }
+    return 1;
+}
+
+/* Consumer side, from the main loop. Returns 0 when there is nothing left. */
+uint8_t Event_Queue_Get(event_t *event)
+{
+    uint8_t t = tail;
+
+    if (t == head) {
+        return 0;
+    }
+
+    __DMB();        // Index read before the slot it guards
+    *event = events[t & (EVENT_QUEUE_SIZE - 1)];
+    __DMB();        // Slot copied out before it is handed back
+    tail = t + 1;
+    return 1;
+}
+
+uint8_t Event_Queue_IsEmpty(void)
+{
+    return head == tail;
+}
+
+uint8_t Event_Queue_GetHighWater(void)
+{
+    return highWater;
+}
+
+uint32_t Event_Queue_GetOverflows(void)
+{
+    return overflows;
+}
@@ -0,0 +1,66 @@
+/**
+******************************************************************************
+* @file           : fixed_math.c
+* @brief          : division-free fixed-point helpers for colour and brightness math
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "fixed_math.h"
+
+/* x * scale / 255: exact at scale 0 and 255, at most one step high in between */
+uint8_t Fixed_Math_Scale8(uint8_t x, uint8_t scale)
+{
+    return ((uint16_t)x * (scale + 1)) >> 8;
+}
+
+/* x * percent / 100, saturating at 255 */
+uint8_t Fixed_Math_Percent8(uint8_t x, uint8_t percent)
+{
+    // x / 100 == ((x / 4) * 5243) >> 17 exactly for every x up to 255 * 255
+    uint32_t result = (((uint32_t)(x * percent) >> 2) * 5243) >> 17;
+    return (result > 255) ? 255 : result;
+}
+
+/* Blend from -> to, frac 0 = from, frac 255 = to */
+uint8_t Fixed_Math_Lerp8(uint8_t from, uint8_t to, uint8_t frac)
+{
+    if (to >= from) {
+        return from + Fixed_Math_Scale8(to - from, frac);
+    }
+    return from - Fixed_Math_Scale8(from - to, frac);
+}
+
+/* Scale every channel of a packed 0x00RRGGBB colour */
+uint32_t Fixed_Math_ScaleColor(uint32_t color, uint8_t scale)
+{
+    uint8_t r = Fixed_Math_Scale8((color >> 16) & 0xFF, scale);
+    uint8_t g = Fixed_Math_Scale8((color >> 8) & 0xFF, scale);
+    uint8_t b = Fixed_Math_Scale8(color & 0xFF, scale);
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+uint32_t Fixed_Math_LerpColor(uint32_t from, uint32_t to, uint8_t frac)
+{
+    uint8_t r = Fixed_Math_Lerp8((from >> 16) & 0xFF, (to >> 16) & 0xFF, frac);
+    uint8_t g = Fixed_Math_Lerp8((from >> 8) & 0xFF, (to >> 8) & 0xFF, frac);
+    uint8_t b = Fixed_Math_Lerp8(from & 0xFF, to & 0xFF, frac);
+    return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+}
+
+q16_t Fixed_Math_MulQ16(q16_t a, q16_t b)
+{
+    return (q16_t)(((int64_t)a * b) >> 16);
+}
@@ -19,47 +19,174 @@
 ******************************************************************************
 */
 #include "flash_storage.h"
+#include "frame_scheduler.h"
 #include <string.h>
 
-static flash_settings_t current_settings;
+#define PAGE_WORDS      (FLASH_STORAGE_PAGE_SIZE / sizeof(uint32_t))
+#define HEADER_WORDS    (sizeof(flash_record_header_t) / sizeof(uint32_t))
+#define RECORD_WORDS    (HEADER_WORDS + sizeof(flash_settings_t) / sizeof(uint32_t) + 1)
+#define LEGACY_LOG_MAGIC    0x5E77106A  // Version 2 record
+#define LEGACY_SINGLE_MAGIC 0xDEADBEEF  // Version 1 record
+#define PAYLOAD_WORDS_V3    1           // Version 3 payload: mode, brightnessLevel, reserved[2]
 
-void Flash_Storage_Init(void)
+static flash_settings_t settings;           // Loaded once at boot, served from RAM
+static uint32_t sequence = 0;               // Of the newest record
+static uint16_t eraseCount = 0;
+static uint8_t stored = 0;                  // settings match a valid record in flash
+static uint16_t nextOffset = 0;             // First free word in the page
+
+/* Save in progress, advanced by Flash_Storage_Step */
+static uint32_t record[RECORD_WORDS];       // Record being programmed
+static int8_t programWord = -1;             // Words of record written so far, -1 = none in flight
+static uint8_t requestPending = 0;          // requested not in flash yet
+static flash_settings_t requested;
+static uint32_t requestTick = 0;            // When the oldest unwritten request came in
+static uint32_t longestStallUs = 0;         // Longest time the flash kept the core off its code
+static uint32_t totalStallUs = 0;
+static uint32_t saveCount = 0;              // Records written since boot
+
+static void Flash_Storage_Defaults(flash_settings_t* out)
+{
+    memset(out, 0, sizeof(*out));
+    out->mode = MODE_STATIC_LOGO;
+    out->brightnessLevel = 2;  // Medium brightness
+}
+
+/* CRC-32 (0x04C11DB7) of whole words on the CRC unit. Weak so a build
+ * without the CRC peripheral (the host build) can supply its own. */
+__weak uint32_t Flash_Storage_Crc(const uint32_t* data, uint32_t words)
 {
-    // Initialize with defaults
-    current_settings.magic = FLASH_STORAGE_MAGIC;
-    current_settings.mode = MODE_STATIC_LOGO;
-    current_settings.brightnessLevel = 2;  // Medium brightness
-    memset(current_settings.reserved, 0, sizeof(current_settings.reserved));
-    current_settings.checksum = Flash_Storage_CalculateChecksum(&current_settings);
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->CR = CRC_CR_RESET;
+    while(words--) {
+        CRC->DR = *data++;
+    }
+    return CRC->DR;
+}
+
+/* Length in words of the record starting at data, whatever its version.
+ * 0 means free space if data is blank, otherwise it cannot be parsed and
+ * nothing after it can be trusted either. */
+static uint16_t Flash_Storage_RecordWords(const uint32_t* data, uint16_t offset)
+{
+    const flash_record_header_t* header = (const flash_record_header_t*)data;
+
+    if(data[0] == 0xFFFFFFFF) {
+        // Version 2 wrote its magic last: a torn record starts blank
+        if((offset & 3) == 0 && offset + 4U <= PAGE_WORDS &&
+           (data[1] & data[2] & data[3]) != 0xFFFFFFFF) {
+            return 4;
+        }
+        return 0;
+    }
+    if(data[0] == LEGACY_SINGLE_MAGIC && offset == 0) {
+        return 4;   // One 16-byte slot, the version 2 log started in the next one
+    }
+    if(data[0] == LEGACY_LOG_MAGIC) {
+        return 4;
+    }
+    if(header->magic == FLASH_STORAGE_RECORD_MAGIC && header->words > HEADER_WORDS &&
+       header->words <= PAGE_WORDS - offset) {
+        return header->words;
+    }
+    return 0;
 }
 
-uint32_t Flash_Storage_CalculateChecksum(flash_settings_t* settings)
+/* Decode a record into out, migrating older layouts. Returns 1 if it is
+ * valid; *seq and *erases are left alone for layouts that lack them. */
+static uint8_t Flash_Storage_Decode(const uint32_t* data, uint16_t words, flash_settings_t* out,
+                                    uint32_t* seq, uint16_t* erases)
 {
-    uint32_t checksum = 0;
-    uint32_t* data = (uint32_t*)settings;
+    Flash_Storage_Defaults(out);
+
+    if(data[0] == LEGACY_SINGLE_MAGIC) {
+        // magic, mode | brightness | 6 reserved bytes, XOR of the first three words.
+        // effect_mode_t is one byte on the target (short enums).
+        if((data[0] ^ data[1] ^ data[2]) != data[3]) return 0;
+        out->mode = (uint8_t)data[1];
+        out->brightnessLevel = (uint8_t)(data[1] >> 8);
+        return 1;
+    }
 
-    // Calculate checksum of all data except the checksum field itself
-    for(int i = 0; i < (sizeof(flash_settings_t) - sizeof(uint32_t)) / sizeof(uint32_t); i++) {
-        checksum ^= data[i];
+    if(data[0] == LEGACY_LOG_MAGIC) {
+        // magic, sequence, mode | brightness | erase count, XOR of the first three words
+        if((data[0] ^ data[1] ^ data[2]) != data[3]) return 0;
+        *seq = data[1];
+        out->mode = (uint8_t)data[2];
+        out->brightnessLevel = (uint8_t)(data[2] >> 8);
+        *erases = (uint16_t)(data[2] >> 16);
+        return 1;
     }
 
-    return checksum;
+    const flash_record_header_t* header = (const flash_record_header_t*)data;
+    if(header->magic != FLASH_STORAGE_RECORD_MAGIC) return 0;
+    if(Flash_Storage_Crc(data, words - 1) != data[words - 1]) return 0;
+
+    // The version picks the payload layout, and each layout has one length.
+    // A version this firmware does not know (written by a newer one after a
+    // downgrade) is rejected: the newest record it can read wins instead.
+    switch(header->version) {
+        case 3:
+            if(words != HEADER_WORDS + PAYLOAD_WORDS_V3 + 1) return 0;
+            memcpy(out, &data[HEADER_WORDS], PAYLOAD_WORDS_V3 * sizeof(uint32_t));
+            break;
+
+        default:
+            return 0;
+    }
+
+    *seq = header->sequence;
+    *erases = header->eraseCount;
+    return 1;
 }
 
-effect_mode_t Flash_Storage_ReadMode(void)
+/* Walk the log once at boot: newest valid record into RAM, and where the free space starts */
+void Flash_Storage_Init(void)
 {
-    flash_settings_t* stored_settings = (flash_settings_t*)FLASH_STORAGE_PAGE_ADDR;
+    const uint32_t* page = (const uint32_t*)FLASH_STORAGE_PAGE_ADDR;
+    flash_settings_t candidate;
+    uint32_t candidateSequence;
+    uint16_t candidateErases;
+    uint16_t offset = 0;
 
-    // Check if flash contains valid data
-    if(stored_settings->magic == FLASH_STORAGE_MAGIC) {
-        // Verify checksum
-        uint32_t calculated_checksum = Flash_Storage_CalculateChecksum(stored_settings);
-        if(calculated_checksum == stored_settings->checksum) {
-            // Data is valid, check if mode is within range
-            if(stored_settings->mode < MODE_COUNT) {
-                return stored_settings->mode;
+    Flash_Storage_Defaults(&settings);
+    stored = 0;
+
+    while(offset < PAGE_WORDS) {
+        uint16_t words = Flash_Storage_RecordWords(&page[offset], offset);
+        if(words == 0) {
+            if(page[offset] != 0xFFFFFFFF) {
+                offset = PAGE_WORDS;    // Unreadable, treat the rest of the page as used
             }
+            break;
+        }
+
+        candidateSequence = 0;
+        candidateErases = eraseCount;
+        if(Flash_Storage_Decode(&page[offset], words, &candidate, &candidateSequence, &candidateErases) &&
+           (!stored || (int32_t)(candidateSequence - sequence) > 0)) {
+            settings = candidate;
+            sequence = candidateSequence;
+            eraseCount = candidateErases;
+            stored = 1;
         }
+
+        offset += words;
+    }
+
+    nextOffset = offset;
+}
+
+const flash_settings_t* Flash_Storage_GetSettings(void)
+{
+    return &settings;
+}
+
+effect_mode_t Flash_Storage_ReadMode(void)
+{
+    // Data is valid, check if mode is within range
+    if(settings.mode < MODE_COUNT) {
+        return (effect_mode_t)settings.mode;
     }
 
     // Return default if data is invalid
@@ -68,63 +195,212 @@ effect_mode_t Flash_Storage_ReadMode(void)
 
 uint8_t Flash_Storage_ReadBrightnessLevel(void)
 {
-    flash_settings_t* stored_settings = (flash_settings_t*)FLASH_STORAGE_PAGE_ADDR;
-
-    // Check if flash contains valid data
-    if(stored_settings->magic == FLASH_STORAGE_MAGIC) {
-        // Verify checksum
-        uint32_t calculated_checksum = Flash_Storage_CalculateChecksum(stored_settings);
-        if(calculated_checksum == stored_settings->checksum) {
-            // Data is valid, check if brightness level is within range
-            if(stored_settings->brightnessLevel < 5) { // 0-4 are valid
-                return stored_settings->brightnessLevel;
-            }
-        }
+    // Data is valid, check if brightness level is within range
+    if(settings.brightnessLevel < 5) { // 0-4 are valid
+        return settings.brightnessLevel;
     }
 
     // Return default if data is invalid
     return 2; // Medium brightness
 }
 
-HAL_StatusTypeDef Flash_Storage_SaveSettings(effect_mode_t mode, uint8_t brightnessLevel)
+uint16_t Flash_Storage_GetEraseCount(void)
+{
+    return eraseCount;
+}
+
+/* Runs from SRAM (.RamFunc, copied at startup): while the flash is busy the
+ * core keeps executing here instead of stalling on an instruction fetch.
+ * control is FLASH_CR_PER to erase the page at address, else FLASH_CR_PG. */
+__attribute__((section(".RamFunc"), noinline))
+static uint32_t Flash_Storage_RamOperation(uint32_t control, uint32_t address, uint16_t data)
+{
+    FLASH->CR |= control;
+    if(control == FLASH_CR_PER) {
+        FLASH->AR = address;
+        FLASH->CR |= FLASH_CR_STRT;
+    } else {
+        *(volatile uint16_t*)address = data;
+    }
+
+    while(FLASH->SR & FLASH_SR_BSY) {
+    }
+
+    FLASH->CR &= ~control;
+    uint32_t errors = FLASH->SR & (FLASH_SR_PGERR | FLASH_SR_WRPERR);
+    FLASH->SR = FLASH_SR_EOP | FLASH_SR_PGERR | FLASH_SR_WRPERR;
+    return errors;
+}
+
+/* SysTick interrupts that came due while masked for stallUs: the first one
+ * is only pending and runs on unmasking, the rest are added to the HAL tick.
+ * The SysTick phase before and after makes the count exact. */
+static void Flash_Storage_CreditTicks(uint32_t stallUs, uint32_t startVal)
+{
+    uint32_t period = SysTick->LOAD + 1;    // HCLK cycles per HAL tick
+    int32_t cycles = (int32_t)(stallUs * (period / 1000)) - ((int32_t)startVal - (int32_t)SysTick->VAL);
+    int32_t wraps = (cycles + (int32_t)(period / 2)) / (int32_t)period;
+
+    if(wraps > 1) {
+        uwTick += (wraps - 1) * uwTickFreq;
+    }
+}
+
+/* Erase the page or program one word, timing how long the flash was busy.
+ * Interrupts are masked throughout: their vectors and handlers are in the
+ * busy flash, so they could only stall the core part-way through. */
+static HAL_StatusTypeDef Flash_Storage_Operation(uint32_t control, uint32_t address, uint32_t word)
 {
-    HAL_StatusTypeDef status = HAL_OK;
+    uint32_t errors;
+    uint32_t primask = __get_PRIMASK();
 
-    // Prepare settings structure
-    current_settings.magic = FLASH_STORAGE_MAGIC;
-    current_settings.mode = mode;
-    current_settings.brightnessLevel = brightnessLevel;
-    current_settings.checksum = Flash_Storage_CalculateChecksum(&current_settings);
+    __disable_irq();
+    uint32_t start = Frame_Scheduler_Micros();
+    uint32_t startVal = SysTick->VAL;
 
-    // Unlock flash for writing
     HAL_FLASH_Unlock();
+    errors = Flash_Storage_RamOperation(control, address, (uint16_t)word);
+    if(control == FLASH_CR_PG && !errors) {
+        errors = Flash_Storage_RamOperation(control, address + 2, (uint16_t)(word >> 16));
+    }
+    HAL_FLASH_Lock();
+
+    // The TIM16 overflow interrupt is masked too, so only the low 16 bits of
+    // the clock are current; the longest operation, an erase, fits in them
+    uint32_t stall = (uint16_t)(Frame_Scheduler_Micros() - start);
+    Flash_Storage_CreditTicks(stall, startVal);
+    __set_PRIMASK(primask);
+
+    if(stall > longestStallUs) {
+        longestStallUs = stall;
+    }
+    totalStallUs += stall;
 
-    // Erase the page first
-    FLASH_EraseInitTypeDef erase_init;
-    uint32_t page_error = 0;
+    return errors ? HAL_ERROR : HAL_OK;
+}
+
+/* Queue the settings for saving, Flash_Storage_Step writes them */
+void Flash_Storage_RequestSave(effect_mode_t mode, uint8_t brightnessLevel)
+{
+    if(!requestPending) {
+        requested = settings;
+        requestTick = HAL_GetTick();
+    }
+    requested.mode = mode;
+    requested.brightnessLevel = brightnessLevel;
+    requestPending = 1;
 
-    erase_init.TypeErase = FLASH_TYPEERASE_PAGES;
-    erase_init.PageAddress = FLASH_STORAGE_PAGE_ADDR;
-    erase_init.NbPages = 1;
+    // Nothing changed since the last save, spare the flash
+    if(programWord < 0 && stored && memcmp(&requested, &settings, sizeof(settings)) == 0) {
+        requestPending = 0;
+    }
+}
 
-    status = HAL_FLASHEx_Erase(&erase_init, &page_error);
+static uint8_t Flash_Storage_PageFull(void)
+{
+    return nextOffset + RECORD_WORDS > PAGE_WORDS;
+}
 
-    if(status == HAL_OK) {
-        // Write the settings structure word by word
-        uint32_t* data = (uint32_t*)&current_settings;
-        uint32_t address = FLASH_STORAGE_PAGE_ADDR;
+/* A save waiting or part-written. A full page alone is not work: it is
+ * compacted by the next save, so the main loop can still reach Stop mode. */
+uint8_t Flash_Storage_HasWork(void)
+{
+    return requestPending || programWord >= 0;
+}
 
-        for(int i = 0; i < sizeof(flash_settings_t) / sizeof(uint32_t); i++) {
-            status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, data[i]);
-            if(status != HAL_OK) {
-                break;
-            }
-            address += sizeof(uint32_t);
+/* Do the next piece of a save if it fits in gapUs, the time the display
+ * can spare. The page erase is the long one: it waits for a big enough gap,
+ * which the static logo and the slow effects have, and is only forced into a
+ * short gap once a save has been waiting on it for FLASH_STORAGE_MAX_DEFER_MS.
+ * A forced erase holds the core for up to FLASH_STORAGE_ERASE_US, so an
+ * effect with a shorter frame period drops a frame or two (the scheduler
+ * skips the missed slots). Returns HAL_BUSY while waiting for a gap. */
+HAL_StatusTypeDef Flash_Storage_Step(uint32_t gapUs)
+{
+    HAL_StatusTypeDef status;
+
+    // A save that finds the page full erases it first, the pending
+    // request then goes in as the first record of the fresh page
+    if(programWord < 0 && requestPending && Flash_Storage_PageFull()) {
+        uint8_t forced = (HAL_GetTick() - requestTick >= FLASH_STORAGE_MAX_DEFER_MS);
+        if(gapUs < FLASH_STORAGE_ERASE_US && !forced) {
+            return HAL_BUSY;
+        }
+
+        status = Flash_Storage_Operation(FLASH_CR_PER, FLASH_STORAGE_PAGE_ADDR, 0);
+        if(status == HAL_OK) {
+            nextOffset = 0;
+            eraseCount++;
         }
+        return status;
     }
 
-    // Lock flash
-    HAL_FLASH_Lock();
+    if(programWord < 0) {
+        if(!requestPending) {
+            return HAL_OK;
+        }
+
+        // Prepare the next record
+        flash_record_header_t* header = (flash_record_header_t*)record;
+        header->magic = FLASH_STORAGE_RECORD_MAGIC;
+        header->version = FLASH_SETTINGS_VERSION;
+        header->words = RECORD_WORDS;
+        header->sequence = sequence + 1;
+        header->eraseCount = eraseCount;
+        header->reserved = 0xFFFF;
+        memcpy(&record[HEADER_WORDS], &requested, sizeof(flash_settings_t));
+        record[RECORD_WORDS - 1] = Flash_Storage_Crc(record, RECORD_WORDS - 1);
+        requestPending = 0;
+        programWord = 0;
+    }
+
+    if(gapUs < FLASH_STORAGE_PROGRAM_US) {
+        return HAL_BUSY;
+    }
+
+    // Header first and CRC last, in page order
+    uint32_t address = FLASH_STORAGE_PAGE_ADDR + (nextOffset + programWord) * sizeof(uint32_t);
+    status = Flash_Storage_Operation(FLASH_CR_PG, address, record[programWord]);
+
+    if(status != HAL_OK) {
+        // Leave the dirty words behind as a torn record and write the
+        // same settings again after it. Without a readable header the log
+        // cannot be walked past this point, so the page has to go.
+        if(!requestPending) {
+            memcpy(&requested, &record[HEADER_WORDS], sizeof(flash_settings_t));
+            requestTick = HAL_GetTick();
+            requestPending = 1;
+        }
+        nextOffset = (programWord == 0) ? PAGE_WORDS : nextOffset + RECORD_WORDS;
+        programWord = -1;
+        return status;
+    }
+
+    programWord++;
+    if(programWord == RECORD_WORDS) {
+        const flash_record_header_t* header = (const flash_record_header_t*)record;
+        memcpy(&settings, &record[HEADER_WORDS], sizeof(flash_settings_t));
+        sequence = header->sequence;
+        stored = 1;
+        nextOffset += RECORD_WORDS;
+        programWord = -1;
+        saveCount++;
+    }
+
+    return HAL_OK;
+}
+
+uint32_t Flash_Storage_GetLongestStall(void)
+{
+    return longestStallUs;
+}
+
+uint32_t Flash_Storage_GetTotalStall(void)
+{
+    return totalStallUs;
+}
 
-    return status;
+uint32_t Flash_Storage_GetSaveCount(void)
+{
+    return saveCount;
 }
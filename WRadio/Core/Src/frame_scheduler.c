@@ -0,0 +1,222 @@
+/**
+******************************************************************************
+* @file           : frame_scheduler.c
+* @brief          : hardware-timed frame clock with jitter statistics
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "frame_scheduler.h"
+#include "event_queue.h"
+#include <string.h>
+
+extern TIM_HandleTypeDef htim16;
+
+static volatile uint16_t overflowCount = 0;   // Upper half of the microsecond clock
+static uint32_t periodUs = 0;                 // 0 = no frame clock, the effect redraws on change only
+static uint32_t deadline = 0;                 // Start of the next frame slot
+static uint32_t frameStart = 0;               // When the frame being rendered was dispatched
+static volatile uint32_t wakeupUs = 0;        // Low_Power sleep timeout, shares the compare
+static volatile uint8_t wakeupArmed = 0;
+static frame_scheduler_stats_t schedulerStats;
+
+void Frame_Scheduler_Init(void)
+{
+    __HAL_TIM_CLEAR_IT(&htim16, TIM_IT_UPDATE);
+    HAL_TIM_Base_Start_IT(&htim16);
+}
+
+/* 32-bit microsecond clock: TIM16 counter plus the overflows counted in its ISR */
+uint32_t Frame_Scheduler_Micros(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    uint16_t high = overflowCount;
+    uint16_t low = __HAL_TIM_GET_COUNTER(&htim16);
+
+    // Wrapped after the interrupts were masked, the ISR has not counted it yet
+    if (__HAL_TIM_GET_FLAG(&htim16, TIM_FLAG_UPDATE) && low < 0x8000) {
+        high++;
+    }
+
+    __set_PRIMASK(primask);
+    return ((uint32_t)high << 16) | low;
+}
+
+/* Point the compare at the frame deadline or the sleep wake-up, whichever
+ * comes first, once it falls inside the current 16-bit window; further
+ * out, the overflow interrupt tries again. */
+static void Frame_Scheduler_ArmCompare(void)
+{
+    __HAL_TIM_DISABLE_IT(&htim16, TIM_IT_CC1);
+
+    uint32_t now = Frame_Scheduler_Micros();
+    uint32_t target = 0;
+    int32_t remaining = 0x10000;
+
+    if (periodUs != 0 && (int32_t)(deadline - now) > 0) {
+        target = deadline;
+        remaining = (int32_t)(deadline - now);
+    }
+    if (wakeupArmed && (int32_t)(wakeupUs - now) > 0 && (int32_t)(wakeupUs - now) < remaining) {
+        target = wakeupUs;
+        remaining = (int32_t)(wakeupUs - now);
+    }
+    if (remaining >= 0x10000) return;
+
+    __HAL_TIM_SET_COMPARE(&htim16, TIM_CHANNEL_1, (uint16_t)target);
+    __HAL_TIM_CLEAR_IT(&htim16, TIM_IT_CC1);
+    __HAL_TIM_ENABLE_IT(&htim16, TIM_IT_CC1);
+
+    // The counter may have passed the compare value while it was being set
+    if ((int32_t)(target - Frame_Scheduler_Micros()) <= 0) {
+        htim16.Instance->EGR = TIM_EGR_CC1G;
+    }
+}
+
+/* Restart the frame clock, the first frame is due immediately */
+void Frame_Scheduler_Start(uint32_t period)
+{
+    memset(&schedulerStats, 0, sizeof(schedulerStats));
+    schedulerStats.periodUs = period;
+    schedulerStats.intervalMinUs = 0xFFFFFFFF;
+
+    periodUs = period;
+    deadline = Frame_Scheduler_Micros();
+    Frame_Scheduler_ArmCompare();
+}
+
+/* True once per frame slot. Slots missed because a render overran are
+ * dropped rather than rendered back to back, so the animation stays on
+ * its time base and only loses frames. */
+uint8_t Frame_Scheduler_FrameDue(void)
+{
+    if (periodUs == 0) return 0;
+
+    uint32_t now = Frame_Scheduler_Micros();
+    if ((int32_t)(now - deadline) < 0) return 0;
+
+    if (schedulerStats.frames > 0) {
+        uint32_t interval = now - frameStart;
+        if (interval < schedulerStats.intervalMinUs) schedulerStats.intervalMinUs = interval;
+        if (interval > schedulerStats.intervalMaxUs) schedulerStats.intervalMaxUs = interval;
+        if (schedulerStats.frames == 1) {
+            schedulerStats.intervalMeanUs = interval;
+        } else {
+            schedulerStats.intervalMeanUs += (int32_t)(interval - schedulerStats.intervalMeanUs) >> 4;
+        }
+    }
+    schedulerStats.frames++;
+    frameStart = now;
+
+    deadline += periodUs;
+    while ((int32_t)(now - deadline) >= 0) {
+        deadline += periodUs;
+        schedulerStats.framesSkipped++;
+    }
+
+    Frame_Scheduler_ArmCompare();
+    return 1;
+}
+
+/* Closes the frame opened by Frame_Scheduler_FrameDue: render plus encode time */
+void Frame_Scheduler_FrameRendered(void)
+{
+    uint32_t renderUs = Frame_Scheduler_Micros() - frameStart;
+
+    if (renderUs > schedulerStats.renderMaxUs) schedulerStats.renderMaxUs = renderUs;
+    if (schedulerStats.frames == 1) {
+        schedulerStats.renderMeanUs = renderUs;
+    } else {
+        schedulerStats.renderMeanUs += (int32_t)(renderUs - schedulerStats.renderMeanUs) >> 4;
+    }
+    if (renderUs > periodUs) {
+        schedulerStats.overruns++;
+    }
+}
+
+/* Microseconds until the next frame, FRAME_SCHEDULER_NO_DEADLINE if idle */
+uint32_t Frame_Scheduler_TimeToNextFrameUs(void)
+{
+    if (periodUs == 0) return FRAME_SCHEDULER_NO_DEADLINE;
+
+    int32_t remaining = (int32_t)(deadline - Frame_Scheduler_Micros());
+    return (remaining > 0) ? (uint32_t)remaining : 0;
+}
+
+/* Milliseconds until the next frame (rounded up), FRAME_SCHEDULER_NO_DEADLINE if idle */
+uint32_t Frame_Scheduler_TimeToNextFrame(void)
+{
+    uint32_t remaining = Frame_Scheduler_TimeToNextFrameUs();
+
+    if (remaining == FRAME_SCHEDULER_NO_DEADLINE) return FRAME_SCHEDULER_NO_DEADLINE;
+    if (remaining == 0) return 0;
+
+    // Round up with a multiply instead of a divide: 1/1000 ~= 1049 / 2^20
+    return ((remaining * 1049) >> 20) + 1;
+}
+
+/* TIM16 update interrupt, every 65.536 ms */
+void Frame_Scheduler_TIM_Overflow(void)
+{
+    overflowCount++;
+    Frame_Scheduler_ArmCompare();
+}
+
+/* Wake the core at timeUs on the Frame_Scheduler_Micros() clock, the frame
+ * deadline keeps its own compare if it comes first */
+void Frame_Scheduler_SetWakeup(uint32_t timeUs)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    wakeupUs = timeUs;
+    wakeupArmed = 1;
+    Frame_Scheduler_ArmCompare();
+
+    __set_PRIMASK(primask);
+}
+
+void Frame_Scheduler_ClearWakeup(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    wakeupArmed = 0;
+    Frame_Scheduler_ArmCompare();
+
+    __set_PRIMASK(primask);
+}
+
+/* TIM16 compare interrupt: wake the main loop when the frame deadline is
+ * reached, a sleep wake-up only has to end the WFI */
+void Frame_Scheduler_TIM_Deadline(void)
+{
+    uint32_t now = Frame_Scheduler_Micros();
+
+    if (periodUs != 0 && (int32_t)(now - deadline) >= 0) {
+        Event_Queue_Post(EVENT_FRAME_DEADLINE, 0, now);
+    }
+    if (wakeupArmed && (int32_t)(now - wakeupUs) >= 0) {
+        wakeupArmed = 0;
+    }
+    Frame_Scheduler_ArmCompare();
+}
+
+const frame_scheduler_stats_t* Frame_Scheduler_GetStats(void)
+{
+    return &schedulerStats;
+}
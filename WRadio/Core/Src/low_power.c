@@ -0,0 +1,107 @@
+/**
+******************************************************************************
+* @file           : low_power.c
+* @brief          : tickless sleep between frames and stop mode while the logo is static
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "low_power.h"
+#include "event_queue.h"
+#include "frame_scheduler.h"
+
+static low_power_stats_t powerStats;
+static uint32_t lastWakeUs = 0;         // Frame_Scheduler_Micros() when the core last woke up
+static uint16_t tickRemainderUs = 0;    // Sleep time not yet folded into uwTick
+
+void Low_Power_Init(void)
+{
+    lastWakeUs = Frame_Scheduler_Micros();
+}
+
+/* SysTick is off while asleep: credit the slept time to the HAL tick */
+static void Low_Power_AdvanceTick(uint32_t sleptUs)
+{
+    uint32_t us = tickRemainderUs + sleptUs;
+
+    while (us >= 1000) {
+        us -= 1000;
+        uwTick += uwTickFreq;
+    }
+    tickRemainderUs = us;
+}
+
+static void Low_Power_Sleep(uint32_t timeoutMs)
+{
+    uint32_t start = Frame_Scheduler_Micros();
+
+    if (timeoutMs > LOW_POWER_MAX_SLEEP_MS) {
+        timeoutMs = LOW_POWER_MAX_SLEEP_MS;
+    }
+
+    Frame_Scheduler_SetWakeup(start + timeoutMs * 1000);
+    HAL_SuspendTick();
+
+    // With PRIMASK set a pending interrupt still ends WFI, it just runs after
+    // __enable_irq. That closes the gap between checking the queue and sleeping.
+    __disable_irq();
+    if (Event_Queue_IsEmpty()) {
+        HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+    }
+    uint32_t slept = Frame_Scheduler_Micros() - start;
+    Low_Power_AdvanceTick(slept);
+    HAL_ResumeTick();
+    __enable_irq();
+
+    Frame_Scheduler_ClearWakeup();
+    powerStats.sleepUs += slept;
+}
+
+static void Low_Power_Stop(void)
+{
+    HAL_SuspendTick();
+
+    __disable_irq();
+    if (Event_Queue_IsEmpty()) {
+        powerStats.stopCount++;
+        HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+        SystemClock_Config();   // Stop mode falls back to HSI without the PLL
+    }
+    HAL_ResumeTick();
+    __enable_irq();
+}
+
+/* Park the core until timeoutMs has passed or an interrupt arrives.
+ * Events already waiting in the queue keep the core awake.
+ * allowStop: nothing is scheduled and only a button edge can change the
+ * display, so Stop mode is used and the EXTI line wakes the core. */
+void Low_Power_Idle(uint32_t timeoutMs, uint8_t allowStop)
+{
+    // 32-bit clock: an active stretch can outlast the 65 ms of a 16-bit count
+    powerStats.activeUs += Frame_Scheduler_Micros() - lastWakeUs;
+
+    if (allowStop) {
+        Low_Power_Stop();
+    } else if (timeoutMs > 0) {
+        Low_Power_Sleep(timeoutMs);
+    }
+
+    lastWakeUs = Frame_Scheduler_Micros();
+}
+
+const low_power_stats_t* Low_Power_GetStats(void)
+{
+    return &powerStats;
+}
@@ -0,0 +1,65 @@
+/**
+******************************************************************************
+* @file           : lut.c
+* @brief          : flash lookup tables for sine, gamma and hue
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "lut.h"
+
+/* 128 + 127 * sin(theta * 2pi / 256): 128 at 0, 255 at 64, 1 at 192 */
+uint8_t Lut_Sin8(uint8_t theta)
+{
+    uint8_t index = theta & (LUT_SIN8_QUARTER - 1);
+
+    // The second and fourth quarters run back down the table
+    if (theta & LUT_SIN8_QUARTER) {
+        index = LUT_SIN8_QUARTER - index;
+    }
+    if (theta & 0x80) {
+        return 128 - lutSin8Quarter[index];
+    }
+    return 128 + lutSin8Quarter[index];
+}
+
+/* Perceived brightness to LED duty, so a linear fade looks linear */
+uint8_t Lut_Gamma8(uint8_t x)
+{
+    return lutGamma8[x];
+}
+
+/* Full-saturation hue as packed 0x00RRGGBB: 0 red, 85 green, 170 blue.
+ * One primary fades out as the next fades in. */
+uint32_t Lut_Hue8(uint8_t hue)
+{
+    uint8_t rise, fall;
+
+    if (hue < LUT_HUE_SECTOR) {
+        rise = lutHue8Ramp[hue];
+        fall = lutHue8Ramp[LUT_HUE_SECTOR - hue];
+        return ((uint32_t)fall << 16) | ((uint32_t)rise << 8);
+    }
+    if (hue < 2 * LUT_HUE_SECTOR) {
+        hue -= LUT_HUE_SECTOR;
+        rise = lutHue8Ramp[hue];
+        fall = lutHue8Ramp[LUT_HUE_SECTOR - hue];
+        return ((uint32_t)fall << 8) | rise;
+    }
+    hue -= 2 * LUT_HUE_SECTOR;
+    rise = lutHue8Ramp[hue];
+    fall = lutHue8Ramp[LUT_HUE_SECTOR - hue];
+    return ((uint32_t)rise << 16) | fall;
+}
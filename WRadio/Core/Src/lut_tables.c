@@ -0,0 +1,47 @@
+/**
+******************************************************************************
+* @file           : lut_tables.c
+* @brief          : sine, gamma and hue lookup tables, generated by
+*                   Host/lut_gen.py: do not edit, change the script
+******************************************************************************
+*/
+#include "lut.h"
+
+/* 127 * sin, first quarter wave */
+const uint8_t lutSin8Quarter[LUT_SIN8_QUARTER + 1] = {
+      0,   3,   6,   9,  12,  16,  19,  22,  25,  28,  31,  34,  37,  40,  43,  46,
+     49,  51,  54,  57,  60,  63,  65,  68,  71,  73,  76,  78,  81,  83,  85,  88,
+     90,  92,  94,  96,  98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+    117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+    127,
+};
+
+/* Gamma 2.2 */
+const uint8_t lutGamma8[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+/* Rising edge of one hue sector, sin^2 crossfade */
+const uint8_t lutHue8Ramp[LUT_HUE_SECTOR + 1] = {
+      0,   0,   0,   1,   1,   2,   3,   4,   6,   7,   9,  10,  12,  14,  17,  19,
+     22,  24,  27,  30,  33,  37,  40,  43,  47,  51,  54,  58,  62,  66,  71,  75,
+     79,  84,  88,  93,  97, 102, 106, 111, 116, 120, 125, 130, 135, 139, 144, 149,
+    153, 158, 162, 167, 171, 176, 180, 184, 189, 193, 197, 201, 204, 208, 212, 215,
+    218, 222, 225, 228, 231, 233, 236, 238, 241, 243, 245, 246, 248, 249, 251, 252,
+    253, 254, 254, 255, 255, 255,
+};
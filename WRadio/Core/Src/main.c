@@ -37,6 +37,11 @@
 /* USER CODE BEGIN Includes */
 #include "ws2812b.h"
 #include "flash_storage.h"
+#include "low_power.h"
+#include "frame_scheduler.h"
+#include "button.h"
+#include "event_queue.h"
+#include "telemetry.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -47,7 +52,6 @@
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
 #define SAVE_DELAY_MS    		2000    // Wait 2 seconds before saving to flash
-#define LONG_PRESS_TIME_MS      1000    // 1 second for long press detection
 #define BRIGHTNESS_LEVELS       5       // Number of brightness levels
 /* USER CODE END PD */
 
@@ -58,16 +62,13 @@
 
 /* Private variables ---------------------------------------------------------*/
 TIM_HandleTypeDef htim3;
+TIM_HandleTypeDef htim16;
 DMA_HandleTypeDef hdma_tim3_ch1_trig;
 
 /* USER CODE BEGIN PV */
 /* Global variables */
 static effect_mode_t currentMode = MODE_STATIC_LOGO;
-static uint32_t lastButtonPress = 0;
 static uint32_t lastModeChange = 0;
-static uint32_t buttonPressStartTime = 0;
-static uint8_t buttonPressed = 0;
-static uint8_t buttonReleased = 1;
 static uint8_t modePendingSave = 0;
 static uint8_t brightnessLevel = 2;
 
@@ -88,9 +89,13 @@ void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
 static void MX_DMA_Init(void);
 static void MX_TIM3_Init(void);
+static void MX_TIM16_Init(void);
 /* USER CODE BEGIN PFP */
-void HandleButtonPress(void);
+void HandleEvents(void);
+void HandleButtonEvent(const button_event_t *event);
+void OnFrameDone(void);
 void HandleFlashSave(void);
+void EnterIdle(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -128,6 +133,7 @@ int main(void)
   MX_GPIO_Init();
   MX_DMA_Init();
   MX_TIM3_Init();
+  MX_TIM16_Init();
   /* USER CODE BEGIN 2 */
 
   HAL_Delay(100);
@@ -143,12 +149,20 @@ int main(void)
   baseBrightness = brightnessLevels[brightnessLevel];
   globalBrightness = baseBrightness;
 
+  Telemetry_Init();
+
   // Initialize the WS2812B driver
   WS2812B_Init();
 
   // Apply the loaded effect immediately
+  Frame_Scheduler_Init();
   WS2812B_RunEffect(currentMode);
 
+  Button_Init();
+  WS2812B_SetFrameDoneCallback(OnFrameDone);
+
+  Low_Power_Init();
+
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -158,10 +172,11 @@ int main(void)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
-    HandleButtonPress();
+    HandleEvents();         // Button edges and wake-ups posted by interrupts
+    WS2812B_RunEffect(currentMode);   // Before any flash work, a press shows right away
     HandleFlashSave();      // Check if we need to save settings
-    WS2812B_RunEffect(currentMode);
-    HAL_Delay(1);
+    Telemetry_Update(currentMode);
+    EnterIdle();               // Sleep until the next frame, DMA completion or button edge
 
   }
   /* USER CODE END 3 */
@@ -264,6 +279,38 @@ static void MX_TIM3_Init(void)
 
 }
 
+/**
+  * @brief TIM16 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_TIM16_Init(void)
+{
+
+  /* USER CODE BEGIN TIM16_Init 0 */
+
+  /* USER CODE END TIM16_Init 0 */
+
+  /* USER CODE BEGIN TIM16_Init 1 */
+
+  /* USER CODE END TIM16_Init 1 */
+  htim16.Instance = TIM16;
+  htim16.Init.Prescaler = 47;
+  htim16.Init.CounterMode = TIM_COUNTERMODE_UP;
+  htim16.Init.Period = 65535;
+  htim16.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+  htim16.Init.RepetitionCounter = 0;
+  htim16.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+  if (HAL_TIM_Base_Init(&htim16) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN TIM16_Init 2 */
+
+  /* USER CODE END TIM16_Init 2 */
+
+}
+
 /**
   * Enable DMA controller clock
   */
@@ -296,68 +343,80 @@ static void MX_GPIO_Init(void)
 
   /*Configure GPIO pin : PA0 */
   GPIO_InitStruct.Pin = GPIO_PIN_0;
-  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
 
+  /* EXTI interrupt init*/
+  HAL_NVIC_SetPriority(EXTI0_1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI0_1_IRQn);
+
 /* USER CODE BEGIN MX_GPIO_Init_2 */
 /* USER CODE END MX_GPIO_Init_2 */
 }
 
 /* USER CODE BEGIN 4 */
 
-void HandleButtonPress(void)
+void HandleEvents(void)
+{
+    event_t event;
+    button_event_t buttonEvent;
+
+    while (Event_Queue_Get(&event)) {
+        switch (event.type) {
+            case EVENT_BUTTON_EDGE:
+                if (Button_HandleEdge(event.arg, event.timeUs, &buttonEvent)) {
+                    HandleButtonEvent(&buttonEvent);
+                }
+                break;
+
+            case EVENT_FRAME_DONE:
+            case EVENT_FRAME_DEADLINE:
+            default:
+                // Only posted to wake the main loop, the effect checks its own timing
+                break;
+        }
+    }
+
+    if (Button_Poll(&buttonEvent)) {
+        HandleButtonEvent(&buttonEvent);
+    }
+}
+
+void HandleButtonEvent(const button_event_t *event)
 {
-    uint8_t buttonState = HAL_GPIO_ReadPin(GPIOA, GPIO_PIN_0);
     uint32_t currentTime = HAL_GetTick();
 
-    if (buttonState == GPIO_PIN_SET && buttonReleased) {
-        // Button just pressed down
-        if (currentTime - lastButtonPress > 50) { // 50ms debounce
-            buttonPressed = 1;
-            buttonReleased = 0;
-            buttonPressStartTime = currentTime;
-            lastButtonPress = currentTime;
+    if (event->type == BUTTON_EVENT_LONG_PRESS) {
+        // LONG PRESS - Change brightness, as soon as the threshold is reached
+        brightnessLevel++;
+        if (brightnessLevel >= BRIGHTNESS_LEVELS) {
+            brightnessLevel = 0;  // Loop back to lowest
         }
-    }
-    else if (buttonState == GPIO_PIN_RESET && !buttonReleased) {
-        // Button just released
-        buttonReleased = 1;
-        buttonPressed = 0;
-
-        uint32_t pressDuration = currentTime - buttonPressStartTime;
-
-        if (pressDuration >= LONG_PRESS_TIME_MS) {
-            // LONG PRESS - Change brightness
-            brightnessLevel++;
-            if (brightnessLevel >= BRIGHTNESS_LEVELS) {
-                brightnessLevel = 0;  // Loop back to lowest
-            }
-
-            // Update base brightness that will be used by all effects
-            baseBrightness = brightnessLevels[brightnessLevel];
-            globalBrightness = baseBrightness;
-
-            // Trigger static logo update if we're in static mode
-            if (currentMode == MODE_STATIC_LOGO) {
-                WS2812B_TriggerStaticLogoUpdate();
-            }
-
-            // Mark settings for saving
-            modePendingSave = 1;
-            lastModeChange = currentTime;
-
-        } else if (pressDuration >= 200) {
-            // SHORT PRESS - Change effect (with minimum 200ms press)
-            currentMode++;
-            if (currentMode >= MODE_COUNT) {
-                currentMode = MODE_STATIC_LOGO;
-            }
-
-            // Mark mode for saving
-            modePendingSave = 1;
-            lastModeChange = currentTime;
+
+        // Update base brightness that will be used by all effects
+        baseBrightness = brightnessLevels[brightnessLevel];
+        globalBrightness = baseBrightness;
+
+        // Show the new brightness now, not at the effect's next frame
+        WS2812B_RefreshEffect();
+        Telemetry_InputEvent(event->timeUs);
+
+        // Mark settings for saving
+        modePendingSave = 1;
+        lastModeChange = currentTime;
+
+    } else if (event->type == BUTTON_EVENT_SHORT_RELEASE) {
+        // SHORT PRESS - Change effect
+        currentMode++;
+        if (currentMode >= MODE_COUNT) {
+            currentMode = MODE_STATIC_LOGO;
         }
+        Telemetry_InputEvent(event->timeUs);
+
+        // Mark mode for saving
+        modePendingSave = 1;
+        lastModeChange = currentTime;
     }
 }
 
@@ -367,12 +426,53 @@ void HandleFlashSave(void)
     if (modePendingSave) {
         uint32_t currentTime = HAL_GetTick();
         if (currentTime - lastModeChange > SAVE_DELAY_MS) {
-            // Save the current mode and brightness level to flash
-            if (Flash_Storage_SaveSettings(currentMode, brightnessLevel) == HAL_OK) {
-                modePendingSave = 0;  // Clear the pending save flag
-            }
+            // Queue the current mode and brightness level for flash
+            Flash_Storage_RequestSave(currentMode, brightnessLevel);
+            modePendingSave = 0;  // Clear the pending save flag
         }
     }
+
+    /* Erase and program in steps, only while the LEDs are idle and only
+     * what fits before the next frame is due */
+    if (Flash_Storage_HasWork() && !WS2812B_IsBusy()) {
+        Flash_Storage_Step(Frame_Scheduler_TimeToNextFrameUs());
+    }
+}
+
+void EnterIdle(void)
+{
+    uint32_t timeout = Frame_Scheduler_TimeToNextFrame();
+    uint32_t currentTime = HAL_GetTick();
+
+    // A pending save needs the CPU awake when its delay runs out
+    if (modePendingSave) {
+        uint32_t sinceChange = currentTime - lastModeChange;
+        uint32_t untilSave = (sinceChange > SAVE_DELAY_MS) ? 0 : SAVE_DELAY_MS + 1 - sinceChange;
+        if (untilSave < timeout) timeout = untilSave;
+    }
+
+    // Long-press threshold or a debounce window that is still open
+    uint32_t untilButton = Button_TimeToNextEvent();
+    if (untilButton < timeout) timeout = untilButton;
+
+    // Stop mode only when nothing is scheduled, in flight or held down
+    uint8_t allowStop = (timeout == FRAME_SCHEDULER_NO_DEADLINE) && !Button_IsHeld() && !WS2812B_IsBusy()
+                        && !Flash_Storage_HasWork();
+
+    Low_Power_Idle(timeout, allowStop);
+}
+
+/* Runs in the DMA / TIM3 interrupt when a frame has been latched */
+void OnFrameDone(void)
+{
+    Event_Queue_Post(EVENT_FRAME_DONE, 0, Frame_Scheduler_Micros());
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == GPIO_PIN_0) {
+    Button_EXTI();
+  }
 }
 
 // Add this function to main.c
@@ -382,6 +482,30 @@ void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim)
     WS2812B_TIM_DMADelayPulseFinished();
   }
 }
+
+void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM3) {
+    WS2812B_TIM_DMADelayPulseHalfFinished();
+  }
+}
+
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM3) {
+    WS2812B_TIM_LatchElapsed();
+  }
+  else if (htim->Instance == TIM16) {
+    Frame_Scheduler_TIM_Overflow();
+  }
+}
+
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim)
+{
+  if (htim->Instance == TIM16) {
+    Frame_Scheduler_TIM_Deadline();
+  }
+}
 /* USER CODE END 4 */
 
 /**
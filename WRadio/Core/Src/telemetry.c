@@ -0,0 +1,222 @@
+/**
+******************************************************************************
+* @file           : telemetry.c
+* @brief          : performance counters at a fixed RAM address, read over SWD
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "telemetry.h"
+#include "frame_scheduler.h"
+#include "flash_storage.h"
+#include "low_power.h"
+#include <string.h>
+
+#if TELEMETRY_ENABLED
+
+__attribute__((section(".telemetry"), used))
+telemetry_t telemetry;
+
+/* Measured where the frame goes by, folded into the block by Telemetry_Update
+ * so only the main loop writes it and the sequence count stays honest */
+static uint32_t frameStart = 0;
+static uint32_t dmaStart = 0;
+static uint8_t frameMode = MODE_STATIC_LOGO;
+static uint8_t dmaMode = MODE_STATIC_LOGO;
+static uint32_t framesRendered = 0;
+static uint16_t renderUs = 0;
+static uint16_t encodeUs = 0;
+static uint8_t renderPending = 0;
+static uint8_t encodePending = 0;
+static volatile uint16_t dmaUs = 0;
+static volatile uint8_t dmaPending = 0;
+static uint32_t inputTimeUs = 0;
+static uint16_t inputUs = 0;
+static uint8_t inputWaiting = 0;            // A button event is not on the LEDs yet
+static uint8_t inputPending = 0;
+
+/* CPU load window */
+static uint32_t windowStart = 0;
+static uint32_t windowActiveUs = 0;
+static uint32_t windowSleepUs = 0;
+
+static uint16_t Telemetry_Elapsed(uint32_t since)
+{
+    uint32_t us = Frame_Scheduler_Micros() - since;
+    return (us > 0xFFFF) ? 0xFFFF : (uint16_t)us;
+}
+
+static void Telemetry_Record(uint16_t *maxUs, uint16_t *meanUs, uint16_t us)
+{
+    if (us > *maxUs) *maxUs = us;
+    if (*meanUs == 0) {
+        *meanUs = us;
+    } else {
+        *meanUs = (uint16_t)(*meanUs + (((int32_t)us - *meanUs) >> 4));
+    }
+}
+
+void Telemetry_Init(void)
+{
+    memset(&telemetry, 0, sizeof(telemetry));
+    telemetry.magic = TELEMETRY_MAGIC;
+    telemetry.version = TELEMETRY_VERSION;
+    telemetry.size = sizeof(telemetry_t);
+
+    windowStart = HAL_GetTick();
+    windowActiveUs = Low_Power_GetStats()->activeUs;
+    windowSleepUs = Low_Power_GetStats()->sleepUs;
+}
+
+/* Called before every effect step, most of them submit nothing */
+void Telemetry_FrameStart(effect_mode_t mode)
+{
+    frameStart = Frame_Scheduler_Micros();
+    frameMode = mode;
+}
+
+/* Time spent waiting for the previous frame to go out is not render time */
+void Telemetry_FrameWaited(uint32_t since)
+{
+    frameStart += Frame_Scheduler_Micros() - since;
+}
+
+/* The effect is done and hands its frame to the transport */
+void Telemetry_FrameSubmitted(void)
+{
+    renderUs = Telemetry_Elapsed(frameStart);
+    renderPending = 1;
+    framesRendered++;
+}
+
+/* A button event changed the mode or the brightness, timeUs is its timestamp */
+void Telemetry_InputEvent(uint32_t timeUs)
+{
+    inputTimeUs = timeUs;
+    inputWaiting = 1;
+}
+
+static void Telemetry_InputShown(void)
+{
+    if (inputWaiting) {
+        inputUs = Telemetry_Elapsed(inputTimeUs);
+        inputWaiting = 0;
+        inputPending = 1;
+    }
+}
+
+/* The frame is encoded and the DMA about to start */
+void Telemetry_FrameEncoded(void)
+{
+    encodeUs = Telemetry_Elapsed(frameStart) - renderUs;
+    encodePending = 1;
+    dmaMode = frameMode;
+    dmaStart = Frame_Scheduler_Micros();
+    Telemetry_InputShown();
+
+    // An effect that sends again in the same step renders from here on
+    frameStart = dmaStart;
+}
+
+/* Nothing changed, the LEDs already show the frame */
+void Telemetry_FrameSkipped(void)
+{
+    Telemetry_InputShown();
+}
+
+/* Interrupt context: the frame and its reset are out */
+void Telemetry_FrameSent(void)
+{
+    dmaUs = Telemetry_Elapsed(dmaStart);
+    dmaPending = 1;
+}
+
+/* Once per main loop pass */
+void Telemetry_Update(effect_mode_t mode)
+{
+    const ws2812b_transport_stats_t *transport = WS2812B_GetTransportStats();
+    telemetry_effect_t *effect = &telemetry.effects[(frameMode < MODE_COUNT) ? frameMode : MODE_STATIC_LOGO];
+
+    telemetry.sequence++;
+    __DMB();
+
+    telemetry.uptimeMs = HAL_GetTick();
+    telemetry.mode = mode;
+
+    if (renderPending) {
+        Telemetry_Record(&effect->renderMaxUs, &effect->renderMeanUs, renderUs);
+        renderPending = 0;
+    }
+    if (encodePending) {
+        Telemetry_Record(&effect->encodeMaxUs, &effect->encodeMeanUs, encodeUs);
+        encodePending = 0;
+    }
+    if (inputPending) {
+        if (inputUs > effect->inputMaxUs) effect->inputMaxUs = inputUs;
+        inputPending = 0;
+    }
+    if (dmaPending) {
+        effect = &telemetry.effects[(dmaMode < MODE_COUNT) ? dmaMode : MODE_STATIC_LOGO];
+        Telemetry_Record(&effect->dmaMaxUs, &effect->dmaMeanUs, dmaUs);
+        dmaPending = 0;
+    }
+
+    telemetry.framesRendered = framesRendered;
+    telemetry.framesSent = transport->framesSent;
+    telemetry.framesSkipped = transport->framesSkipped;
+    telemetry.framesDropped = transport->framesDropped;
+    telemetry.timeouts = transport->timeouts;
+    telemetry.flashSaves = Flash_Storage_GetSaveCount();
+    telemetry.flashErases = Flash_Storage_GetEraseCount();
+    telemetry.flashStallMaxUs = Flash_Storage_GetLongestStall();
+    telemetry.flashStallTotalUs = Flash_Storage_GetTotalStall();
+
+    if (HAL_GetTick() - windowStart >= TELEMETRY_LOAD_WINDOW_MS) {
+        const low_power_stats_t *power = Low_Power_GetStats();
+
+        // The counts wrap, the differences over one window do not
+        uint32_t active = power->activeUs - windowActiveUs;
+        uint32_t total = active + (power->sleepUs - windowSleepUs);
+
+        // 32-bit divides only, a window is about a second of microseconds
+        if (total >= 1000) {
+            uint32_t load = active / (total / 1000);
+            telemetry.cpuLoadPermille = (load > 1000) ? 1000 : (uint16_t)load;
+            if (telemetry.cpuLoadPermille > telemetry.cpuLoadMaxPermille) {
+                telemetry.cpuLoadMaxPermille = telemetry.cpuLoadPermille;
+            }
+        }
+        windowStart = HAL_GetTick();
+        windowActiveUs = power->activeUs;
+        windowSleepUs = power->sleepUs;
+    }
+
+    __DMB();
+    telemetry.sequence++;
+}
+
+#else
+
+void Telemetry_Init(void) {}
+void Telemetry_FrameStart(effect_mode_t mode) { (void)mode; }
+void Telemetry_FrameWaited(uint32_t since) { (void)since; }
+void Telemetry_FrameSubmitted(void) {}
+void Telemetry_FrameEncoded(void) {}
+void Telemetry_FrameSkipped(void) {}
+void Telemetry_FrameSent(void) {}
+void Telemetry_InputEvent(uint32_t timeUs) { (void)timeUs; }
+void Telemetry_Update(effect_mode_t mode) { (void)mode; }
+
+#endif /* TELEMETRY_ENABLED */
@@ -20,16 +20,34 @@
 */
 #include "ws2812b.h"
 #include "main.h"
+#include "fixed_math.h"
+#include "lut.h"
+#include "frame_scheduler.h"
+#include "animation.h"
+#include "telemetry.h"
 #include <string.h>
 #include <stdbool.h>
 
 #define WS2812B_ONE_PULSE   38
 #define WS2812B_ZERO_PULSE  19
 #define BASE_BRIGHTNESS     100
-
-uint8_t ledBuffer[WS2812B_BUFFER_SIZE];
+#define COMET_FADE          FIXED_SCALE8(0.85)  // Trail keeps 85% per step
+#define SCANNER_WIDTH       3                   // Pixels in the scanner beam
+#define BREATHE_PHASE_STEP  218                 // 65536 / 300: one breath every 300 steps
+#define BREATHE_START_PHASE 0xC000              // Bottom of the sine, 50% of base
+
+#if WS2812B_STREAMING
+/* The ring is encoded from the front buffer while the effects render into the
+ * back buffer (currentColors). In buffered mode ledBuffer already holds the
+ * encoded copy of the frame on the wire, so one pixel array is enough. */
+__ALIGNED(4) uint8_t ledRing[WS2812B_RING_SIZE];
+static uint32_t pixelBuffers[2][LED_COUNT];
+uint32_t *currentColors = pixelBuffers[0];
+static uint32_t *frontColors = pixelBuffers[1];
+#else
+__ALIGNED(4) uint8_t ledBuffer[WS2812B_BUFFER_SIZE];
 uint32_t currentColors[LED_COUNT];
-volatile bool transferComplete = false;
+#endif
 uint8_t globalBrightness = BASE_BRIGHTNESS;
 extern uint8_t baseBrightness;
 
@@ -38,181 +56,709 @@ extern uint8_t baseBrightness;
 #define R_START 20
 #define R_END 28
 
+#define WS2812B_RING_HALF   (WS2812B_RING_SIZE / 2)
+
 extern TIM_HandleTypeDef htim3;
 extern DMA_HandleTypeDef hdma_tim3_ch1_trig;
 
 static uint8_t staticLogoNeedsUpdate = 1;
+static uint8_t logoNeedsRender = 1;     // Set on mode change for effects that only re-light the logo
+static uint8_t refreshPending = 0;      // WS2812B_RefreshEffect: send once without waiting for the frame slot
+static uint8_t clockRestartPending = 0; // New effect or frame period: restart the frame clock
+static uint16_t framePeriodMs = 0;      // WS2812B_SetFramePeriod, 0 = one frame per animation step
+
+/* Pixels are stored at full scale, brightness is applied by the encoder.
+ * frameScale is latched per frame so a brightness change never lands mid-frame. */
+static uint8_t segmentBrightness[WS2812B_SEGMENT_COUNT] = {255, 255, 255};
+static uint8_t frameScale[WS2812B_SEGMENT_COUNT];
+
+/* One bit per pixel written with a new value since it was last encoded */
+static uint32_t dirtyPixels[(LED_COUNT + 31) / 32];
+
+#if WS2812B_DITHER
+/* Low byte of each channel's 8.8 scaled value, left over from the last frame */
+static uint8_t ditherError[LED_COUNT][3];
+#endif
+
+static volatile ws2812b_state_t transportState = WS2812B_READY;
+static uint32_t submitTick = 0;
+static ws2812b_frame_done_cb_t frameDoneCallback = NULL;
+static ws2812b_transport_stats_t transportStats;
+
+#if WS2812B_STREAMING
+static uint16_t streamPixel = 0;               // Next pixel to encode into the ring
+static uint8_t streamHalfHasData[2];           // Half holds at least one pixel
+static volatile uint8_t latchUpdates = 0;      // TIM3 updates left until the latch ends
+#endif
+static ws2812b_stream_stats_t streamStats = {
+    .refillDeadlineCycles = (WS2812B_RING_HALF) * 60,
+};
+
+static void WS2812B_MarkAllDirty(void)
+{
+    memset(dirtyPixels, 0xFF, sizeof(dirtyPixels));
+#if LED_COUNT % 32
+    // Bits past the last pixel are never encoded, so they would never clear
+    dirtyPixels[LED_COUNT / 32] = (1UL << (LED_COUNT % 32)) - 1;
+#endif
+}
 
 void WS2812B_Init(void)
 {
-    memset(currentColors, 0, sizeof(currentColors));
+    memset(currentColors, 0, LED_COUNT * sizeof(uint32_t));
+    WS2812B_MarkAllDirty();
     globalBrightness = baseBrightness;
+
+#if WS2812B_STREAMING
+    // CubeMX generates the channel in normal mode, the ring needs circular
+    hdma_tim3_ch1_trig.Init.Mode = DMA_CIRCULAR;
+    HAL_DMA_Init(&hdma_tim3_ch1_trig);
+#endif
+
     WS2812B_SetLogoColors();
 }
 
+/* Pack a full-scale colour, brightness is applied when the frame is encoded */
 uint32_t WS2812B_Color(uint8_t r, uint8_t g, uint8_t b)
 {
-    r = (r * globalBrightness) / 255;
-    g = (g * globalBrightness) / 255;
-    b = (b * globalBrightness) / 255;
     return ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
 }
 
-void WS2812B_PrepareBuffer(void)
+/* All pixel writes go through here so unchanged pixels are not re-encoded */
+void WS2812B_SetPixel(uint16_t index, uint32_t color)
+{
+    if (index >= LED_COUNT || currentColors[index] == color) return;
+
+    currentColors[index] = color;
+    dirtyPixels[index >> 5] |= 1UL << (index & 31);
+}
+
+void WS2812B_SetLED(uint16_t index, uint8_t red, uint8_t green, uint8_t blue)
+{
+    WS2812B_SetPixel(index, WS2812B_Color(red, green, blue));
+}
+
+void WS2812B_SetAllLED(uint8_t red, uint8_t green, uint8_t blue)
 {
-    uint16_t bufferIndex = 0;
+    uint32_t color = WS2812B_Color(red, green, blue);
 
     for (uint16_t i = 0; i < LED_COUNT; i++) {
-        uint32_t color = currentColors[i];
-        uint8_t green = (color >> 8) & 0xFF;
-        uint8_t red = (color >> 16) & 0xFF;
-        uint8_t blue = color & 0xFF;
+        WS2812B_SetPixel(i, color);
+    }
+}
 
-        for (int8_t bit = 7; bit >= 0; bit--) {
-            ledBuffer[bufferIndex++] = (green & (1 << bit)) ? WS2812B_ONE_PULSE : WS2812B_ZERO_PULSE;
-        }
-        for (int8_t bit = 7; bit >= 0; bit--) {
-            ledBuffer[bufferIndex++] = (red & (1 << bit)) ? WS2812B_ONE_PULSE : WS2812B_ZERO_PULSE;
+static uint8_t WS2812B_SegmentScale(uint8_t segment)
+{
+    return Fixed_Math_Scale8(segmentBrightness[segment], globalBrightness);
+}
+
+/* Anything to send: a changed pixel or a brightness that differs from the last frame */
+static uint8_t WS2812B_FramePending(void)
+{
+#if WS2812B_DITHER
+    return 1;   // The dithered output changes every frame
+#else
+    for (uint8_t i = 0; i < sizeof(dirtyPixels) / sizeof(dirtyPixels[0]); i++) {
+        if (dirtyPixels[i]) return 1;
+    }
+    for (uint8_t i = 0; i < WS2812B_SEGMENT_COUNT; i++) {
+        if (frameScale[i] != WS2812B_SegmentScale(i)) return 1;
+    }
+    return 0;
+#endif
+}
+
+void WS2812B_SetSegmentBrightness(ws2812b_segment_t segment, uint8_t brightness)
+{
+    if (segment < WS2812B_SEGMENT_COUNT) {
+        segmentBrightness[segment] = brightness;
+    }
+}
+
+/* Latch master x segment brightness for the frame about to be encoded.
+ * A change means every pixel has to be encoded again. */
+static void WS2812B_LatchFrameScale(void)
+{
+    for (uint8_t i = 0; i < WS2812B_SEGMENT_COUNT; i++) {
+        uint8_t scale = WS2812B_SegmentScale(i);
+        if (frameScale[i] != scale) {
+            frameScale[i] = scale;
+            WS2812B_MarkAllDirty();
         }
-        for (int8_t bit = 7; bit >= 0; bit--) {
-            ledBuffer[bufferIndex++] = (blue & (1 << bit)) ? WS2812B_ONE_PULSE : WS2812B_ZERO_PULSE;
+    }
+}
+
+static uint8_t WS2812B_PixelScale(uint16_t index)
+{
+    if (index < R_START) return frameScale[WS2812B_SEGMENT_W];
+    if (index <= R_END) return frameScale[WS2812B_SEGMENT_R];
+    return frameScale[WS2812B_SEGMENT_BACKGROUND];
+}
+
+/* Pulse widths for the four bits of a nibble, MSB first, packed so a single
+ * little-endian word store writes them in output order */
+#define WS2812B_PULSE(n, bit)   ((((n) >> (bit)) & 1) ? WS2812B_ONE_PULSE : WS2812B_ZERO_PULSE)
+#define WS2812B_NIBBLE(n)       ((uint32_t)WS2812B_PULSE(n, 3) | ((uint32_t)WS2812B_PULSE(n, 2) << 8) | \
+                                 ((uint32_t)WS2812B_PULSE(n, 1) << 16) | ((uint32_t)WS2812B_PULSE(n, 0) << 24))
+
+static const uint32_t nibblePulses[16] = {
+    WS2812B_NIBBLE(0),  WS2812B_NIBBLE(1),  WS2812B_NIBBLE(2),  WS2812B_NIBBLE(3),
+    WS2812B_NIBBLE(4),  WS2812B_NIBBLE(5),  WS2812B_NIBBLE(6),  WS2812B_NIBBLE(7),
+    WS2812B_NIBBLE(8),  WS2812B_NIBBLE(9),  WS2812B_NIBBLE(10), WS2812B_NIBBLE(11),
+    WS2812B_NIBBLE(12), WS2812B_NIBBLE(13), WS2812B_NIBBLE(14), WS2812B_NIBBLE(15),
+};
+
+/* Brightness-scaled colour of one pixel as it goes on the wire */
+static uint32_t WS2812B_ScalePixel(uint16_t index, uint32_t color, uint8_t scale)
+{
+#if WS2812B_DITHER
+    uint8_t *error = ditherError[index];
+    uint32_t scaled = 0;
+
+    // Same product as Fixed_Math_Scale8, kept at 8.8 until the error is added
+    for (int8_t shift = 16; shift >= 0; shift -= 8) {
+        uint16_t value = ((color >> shift) & 0xFF) * (scale + 1) + *error;
+        *error++ = value & 0xFF;
+        scaled |= (uint32_t)(value >> 8) << shift;
+    }
+    return scaled;
+#else
+    (void)index;
+    return Fixed_Math_ScaleColor(color, scale);
+#endif
+}
+
+/* Expand one scaled 0x00RRGGBB pixel into 24 pulse widths, GRB order, MSB
+ * first. dst must be word aligned: six table lookups and six word stores. */
+static void WS2812B_EncodePixel(uint8_t *dst, uint32_t color)
+{
+    uint32_t *out = (uint32_t *)dst;
+
+    out[0] = nibblePulses[(color >> 12) & 0x0F];    // Green
+    out[1] = nibblePulses[(color >> 8) & 0x0F];
+    out[2] = nibblePulses[(color >> 20) & 0x0F];    // Red
+    out[3] = nibblePulses[(color >> 16) & 0x0F];
+    out[4] = nibblePulses[(color >> 4) & 0x0F];     // Blue
+    out[5] = nibblePulses[color & 0x0F];
+}
+
+#if WS2812B_STREAMING
+/* Elapsed HCLK cycles since a SysTick->VAL snapshot (SysTick counts down) */
+static uint32_t WS2812B_CyclesSince(uint32_t start)
+{
+    uint32_t now = SysTick->VAL;
+    return (start >= now) ? (start - now) : (start + SysTick->LOAD + 1 - now);
+}
+#endif
+
+#if WS2812B_BENCHMARK
+#if WS2812B_STREAMING
+#define WS2812B_BENCH_BUFFER    ledRing
+#else
+#define WS2812B_BENCH_BUFFER    ledBuffer
+#endif
+
+static uint32_t effectMaxCycles[MODE_COUNT];
+
+/* Free-running HCLK cycle count built from the tick and SysTick->VAL */
+static uint32_t WS2812B_CycleStamp(void)
+{
+    uint32_t tick, val;
+
+    do {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+
+    return tick * (SysTick->LOAD + 1) + (SysTick->LOAD - val);
+}
+
+/* Worst-case cycles of one step of the given effect, including the encode */
+uint32_t WS2812B_GetEffectCycles(effect_mode_t mode)
+{
+    return (mode < MODE_COUNT) ? effectMaxCycles[mode] : 0;
+}
+
+/* Bit-by-bit reference encoder the lookup table replaced */
+static void WS2812B_EncodePixelLoop(uint8_t *dst, uint32_t color)
+{
+    uint32_t grb = ((color & 0x0000FF00) << 8) | ((color & 0x00FF0000) >> 8) | (color & 0xFF);
+
+    for (int8_t bit = 23; bit >= 0; bit--) {
+        *dst++ = (grb & (1UL << bit)) ? WS2812B_ONE_PULSE : WS2812B_ZERO_PULSE;
+    }
+}
+
+/* Encode the current pixels with both encoders and report cycles per LED.
+ * Returns 0 if the two outputs differ. Run with the transport idle, it
+ * borrows the DMA buffer. */
+uint8_t WS2812B_BenchmarkEncoder(uint32_t *loopCyclesPerLed, uint32_t *lutCyclesPerLed)
+{
+    static __ALIGNED(4) uint8_t reference[24];
+    uint8_t *dst = (uint8_t *)WS2812B_BENCH_BUFFER;
+    uint8_t match = 1;
+    uint32_t start;
+
+    start = WS2812B_CycleStamp();
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        WS2812B_EncodePixelLoop(dst, currentColors[i]);
+    }
+    *loopCyclesPerLed = (WS2812B_CycleStamp() - start) / LED_COUNT;
+
+    start = WS2812B_CycleStamp();
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        WS2812B_EncodePixel(dst, currentColors[i]);
+    }
+    *lutCyclesPerLed = (WS2812B_CycleStamp() - start) / LED_COUNT;
+
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        WS2812B_EncodePixelLoop(reference, currentColors[i]);
+        WS2812B_EncodePixel(dst, currentColors[i]);
+        if (memcmp(reference, dst, 24) != 0) {
+            match = 0;
         }
     }
 
-    for (uint16_t i = 0; i < WS2812B_RESET_LEN; i++) {
-        ledBuffer[bufferIndex++] = 0;
+    // The persistent buffer was overwritten, encode everything next frame
+    WS2812B_MarkAllDirty();
+
+    return match;
+}
+#endif
+
+/* Runs in interrupt context once the last bit and the reset are out */
+static void WS2812B_FrameDone(void)
+{
+    transportState = WS2812B_READY;
+    transportStats.framesSent++;
+    Telemetry_FrameSent();
+
+    if (frameDoneCallback != NULL) {
+        frameDoneCallback();
+    }
+}
+
+#if WS2812B_STREAMING
+
+static void WS2812B_FillHalf(uint8_t half)
+{
+    uint8_t *dst = &ledRing[half * WS2812B_RING_HALF];
+
+    streamHalfHasData[half] = (streamPixel < LED_COUNT);
+
+    for (uint8_t i = 0; i < WS2812B_RING_LEDS / 2; i++) {
+        if (streamPixel < LED_COUNT) {
+            uint32_t color = WS2812B_ScalePixel(streamPixel, frontColors[streamPixel], WS2812B_PixelScale(streamPixel));
+            WS2812B_EncodePixel(dst, color);
+            streamPixel++;
+        } else {
+            memset(dst, 0, 24);
+        }
+        dst += 24;
     }
 }
 
-void WS2812B_SendToLEDs(void)
+/* Data is out and the line has been low for a full ring half: stop feeding the
+ * timer (CCR1 stays 0) and let TIM3 itself time the rest of the reset by
+ * stretching its period to WS2812B_LATCH_CYCLES. */
+static void WS2812B_StartLatch(void)
 {
-    transferComplete = false;
+    __HAL_TIM_DISABLE_DMA(&htim3, TIM_DMA_CC1);
+    // Straight to the register: the macro would also overwrite Init.Period,
+    // which StopTransport restores the bit period from
+    htim3.Instance->ARR = WS2812B_LATCH_CYCLES - 1;
+
+    // First update loads the preloaded ARR, the second one ends the latch
+    latchUpdates = 2;
+    __HAL_TIM_CLEAR_IT(&htim3, TIM_IT_UPDATE);
+    __HAL_TIM_ENABLE_IT(&htim3, TIM_IT_UPDATE);
+}
+
+static void WS2812B_StopTransport(void)
+{
+    __HAL_TIM_DISABLE_IT(&htim3, TIM_IT_UPDATE);
+    latchUpdates = 0;
     HAL_TIM_PWM_Stop_DMA(&htim3, TIM_CHANNEL_1);
 
-    WS2812B_PrepareBuffer();
+    // Restore the bit period, UG loads it straight away while the counter is off
+    __HAL_TIM_SET_AUTORELOAD(&htim3, htim3.Init.Period);
+    htim3.Instance->EGR = TIM_EGR_UG;
+    __HAL_TIM_CLEAR_IT(&htim3, TIM_IT_UPDATE);
+}
 
-    // Cast uint8_t buffer to uint32_t for DMA (DMA expects uint32_t pointer)
-    if (HAL_TIM_PWM_Start_DMA(&htim3, TIM_CHANNEL_1, (uint32_t*)ledBuffer, WS2812B_BUFFER_SIZE) != HAL_OK) {
+/* Called from the DMA ISR once the given ring half has been handed to TIM3 */
+static void WS2812B_StreamRefill(uint8_t half)
+{
+    uint32_t start = SysTick->VAL;
+
+    if (!streamHalfHasData[half]) {
+        WS2812B_StartLatch();
         return;
     }
 
-    uint32_t timeout = HAL_GetTick() + 100;
-    while (!transferComplete && HAL_GetTick() < timeout) {
+    WS2812B_FillHalf(half);
+
+    // While refilling half 0 the DMA must still be reading half 1 and vice versa
+    uint32_t remaining = __HAL_DMA_GET_COUNTER(&hdma_tim3_ch1_trig);
+    if ((half == 0) ? (remaining > WS2812B_RING_HALF) : (remaining <= WS2812B_RING_HALF)) {
+        streamStats.underruns++;
+    }
+
+    uint32_t cycles = WS2812B_CyclesSince(start);
+    if (cycles > streamStats.refillMaxCycles) {
+        streamStats.refillMaxCycles = cycles;
+    }
+}
+
+/* Frame boundary: the transport is idle, so the rendered back buffer becomes
+ * the front one in a single pointer swap. The new back buffer is refreshed
+ * so effects that build on the previous frame (comet trail, fill) continue. */
+static void WS2812B_SwapBuffers(void)
+{
+    uint32_t *rendered = currentColors;
+
+    currentColors = frontColors;
+    frontColors = rendered;
+    memcpy(currentColors, frontColors, LED_COUNT * sizeof(uint32_t));
+}
+
+void WS2812B_PrepareBuffer(void)
+{
+    WS2812B_SwapBuffers();
+    WS2812B_LatchFrameScale();
+
+    // The ring always encodes the whole chain, dirty bits only gate the submit
+    memset(dirtyPixels, 0, sizeof(dirtyPixels));
+    transportStats.pixelsEncoded += LED_COUNT;
+
+    streamPixel = 0;
+    WS2812B_FillHalf(0);
+    WS2812B_FillHalf(1);
+}
+
+static HAL_StatusTypeDef WS2812B_StartTransport(void)
+{
+    return HAL_TIM_PWM_Start_DMA(&htim3, TIM_CHANNEL_1, (uint32_t*)ledRing, WS2812B_RING_SIZE);
+}
+
+void WS2812B_TIM_DMADelayPulseFinished(void)
+{
+    WS2812B_StreamRefill(1);
+}
+
+void WS2812B_TIM_DMADelayPulseHalfFinished(void)
+{
+    WS2812B_StreamRefill(0);
+}
+
+void WS2812B_TIM_LatchElapsed(void)
+{
+    if (latchUpdates == 0 || --latchUpdates != 0) return;
+
+    WS2812B_StopTransport();
+    WS2812B_FrameDone();
+}
+
+#else
+
+/* ledBuffer persists between frames: only the 24 slots of pixels that changed
+ * since the last frame are encoded again. The reset tail never changes. */
+void WS2812B_PrepareBuffer(void)
+{
+    WS2812B_LatchFrameScale();
+
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        uint32_t mask = 1UL << (i & 31);
+
+        if (WS2812B_DITHER || (dirtyPixels[i >> 5] & mask)) {
+            dirtyPixels[i >> 5] &= ~mask;
+            uint32_t color = WS2812B_ScalePixel(i, currentColors[i], WS2812B_PixelScale(i));
+            WS2812B_EncodePixel(&ledBuffer[i * 24], color);
+            transportStats.pixelsEncoded++;
+        }
     }
+
+    memset(&ledBuffer[LED_COUNT * 24], 0, WS2812B_RESET_LEN);
+}
+
+static void WS2812B_StopTransport(void)
+{
+    HAL_TIM_PWM_Stop_DMA(&htim3, TIM_CHANNEL_1);
+}
+
+static HAL_StatusTypeDef WS2812B_StartTransport(void)
+{
+    // Cast uint8_t buffer to uint32_t for DMA (DMA expects uint32_t pointer)
+    return HAL_TIM_PWM_Start_DMA(&htim3, TIM_CHANNEL_1, (uint32_t*)ledBuffer, WS2812B_BUFFER_SIZE);
 }
 
 void WS2812B_TIM_DMADelayPulseFinished(void)
 {
-    transferComplete = true;
+    WS2812B_FrameDone();
 }
 
-void WS2812B_SetLogoColors(void)
+void WS2812B_TIM_DMADelayPulseHalfFinished(void)
+{
+}
+
+void WS2812B_TIM_LatchElapsed(void)
+{
+}
+
+#endif /* WS2812B_STREAMING */
+
+/* Queue the current pixels for transmission without waiting for the wire.
+ * Returns HAL_BUSY (and counts a dropped frame) if a frame is still going out. */
+HAL_StatusTypeDef WS2812B_SubmitFrame(void)
+{
+    if (transportState == WS2812B_BUSY) {
+        transportStats.framesDropped++;
+        return HAL_BUSY;
+    }
+
+    Telemetry_FrameSubmitted();
+
+    // The LEDs still show the last frame, nothing to do
+    if (!WS2812B_FramePending()) {
+        transportStats.framesSkipped++;
+        Telemetry_FrameSkipped();
+        return HAL_OK;
+    }
+
+    WS2812B_StopTransport();
+    WS2812B_PrepareBuffer();
+    Telemetry_FrameEncoded();
+
+    submitTick = HAL_GetTick();
+    transportState = WS2812B_BUSY;
+
+    if (WS2812B_StartTransport() != HAL_OK) {
+        transportState = WS2812B_READY;
+        return HAL_ERROR;
+    }
+
+    return HAL_OK;
+}
+
+/* Returns the transport state, recovering a frame that never completed */
+ws2812b_state_t WS2812B_Poll(void)
+{
+    if (transportState == WS2812B_BUSY && HAL_GetTick() - submitTick >= WS2812B_TIMEOUT_MS) {
+        WS2812B_StopTransport();
+        transportStats.timeouts++;
+        WS2812B_MarkAllDirty();     // The chain state is unknown, resend everything
+        transportState = WS2812B_READY;
+    }
+
+    return transportState;
+}
+
+uint8_t WS2812B_IsBusy(void)
+{
+    return WS2812B_Poll() == WS2812B_BUSY;
+}
+
+void WS2812B_SetFrameDoneCallback(ws2812b_frame_done_cb_t callback)
+{
+    frameDoneCallback = callback;
+}
+
+/* Waits only for a frame that is still on the wire, then submits and returns */
+void WS2812B_SendToLEDs(void)
+{
+    uint32_t waitStart = Frame_Scheduler_Micros();
+
+    while (WS2812B_IsBusy()) {
+    }
+    Telemetry_FrameWaited(waitStart);
+
+    WS2812B_SubmitFrame();
+}
+
+const ws2812b_stream_stats_t* WS2812B_GetStreamStats(void)
+{
+    return &streamStats;
+}
+
+const ws2812b_transport_stats_t* WS2812B_GetTransportStats(void)
+{
+    return &transportStats;
+}
+
+/* Draw the logo into the pixel buffer without sending it */
+static void WS2812B_RenderLogo(void)
 {
     /* W = Magenta */
     for(int i = W_START; i <= W_END; i++) {
-        currentColors[i] = WS2812B_Color(255, 0, 100);
+        WS2812B_SetPixel(i, WS2812B_Color(255, 0, 100));
     }
 
     /* R = White */
     for(int i = R_START; i <= R_END; i++) {
-        currentColors[i] = WS2812B_Color(255, 255, 255);
+        WS2812B_SetPixel(i, WS2812B_Color(255, 255, 255));
     }
 
     /* Background = DARK BLUE */
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Color(30, 30, 150);
+        WS2812B_SetPixel(i, WS2812B_Color(30, 30, 150));
     }
 
+}
+
+void WS2812B_SetLogoColors(void)
+{
+    WS2812B_RenderLogo();
     WS2812B_SendToLEDs();
 }
 
 void WS2812B_Clear(void)
 {
-    memset(currentColors, 0, sizeof(currentColors));
+    WS2812B_SetAllLED(0, 0, 0);
     WS2812B_SendToLEDs();
 }
 
+/* State of the running effect. The effects share one arena, so only the
+ * active one takes RAM; a mode change zeroes it and runs the effect's init. */
+static union {
+    struct {
+        uint16_t phase;         // Lut_Sin8 angle, 8.8
+    } breathe;
+    struct {
+        uint16_t pixel;
+        uint8_t lit;
+    } sparkle;
+    struct {
+        uint16_t pos;
+        uint8_t section;        // 0 = W, 1 = R
+    } wave;
+    struct {
+        uint8_t high;
+    } pulse;
+    struct {
+        uint8_t step;
+    } rainbow;
+    struct {
+        uint16_t pos;
+        uint8_t forward;
+    } comet;
+    struct {
+        uint8_t pos;
+        uint8_t stage;          // 0 = fill W, 1 = fill R, 2 = empty
+    } fill;
+    struct {
+        uint16_t pos;
+        uint8_t forward;
+    } scanner;
+    struct {
+        uint8_t hue;
+    } colorShift;
+    struct {
+        uint8_t section;        // 0 = W lit, 1 = R lit
+        uint8_t count;
+    } strobe;
+} effectState;
+
+static animation_phase_t effectAnimation;
+static uint16_t effectSteps;    // Animation steps due this frame, set by WS2812B_RunEffect
+
+static void WS2812B_StaticLogoInit(void)
+{
+    staticLogoNeedsUpdate = 1;
+}
+
 void WS2812B_StaticLogoEffect(void)
 {
-    // Only update if needed (when switching to static mode or brightness changed)
-    if (staticLogoNeedsUpdate) {
+    // Only update if needed (when switching to static mode or brightness changed),
+    // a dithered logo is sent every frame
+    if (staticLogoNeedsUpdate || WS2812B_DITHER) {
         globalBrightness = baseBrightness;  // Set brightness for static logo
-        WS2812B_SetLogoColors();
+        if (logoNeedsRender) {
+            WS2812B_RenderLogo();           // A brightness change only needs a resend
+            logoNeedsRender = 0;
+        }
+        WS2812B_SendToLEDs();
         staticLogoNeedsUpdate = 0;  // Clear the update flag
     }
 }
 
-void WS2812B_BreatheEffect(void)
+static void WS2812B_BreatheInit(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint8_t breathDir = 1;
-    static uint8_t breathBrightness = 50;  // Start at 50% of base
-
-    if (HAL_GetTick() - lastUpdate < 30) return;
-    lastUpdate = HAL_GetTick();
+    effectState.breathe.phase = BREATHE_START_PHASE;
+}
 
-    if (breathDir) {
-        breathBrightness++;
-        if (breathBrightness >= 200) breathDir = 0;  // Max 200% of base
-    } else {
-        breathBrightness--;
-        if (breathBrightness <= 50) breathDir = 1;   // Min 50% of base
+void WS2812B_BreatheEffect(void)
+{
+    effectState.breathe.phase += BREATHE_PHASE_STEP * effectSteps;
+
+    // Sine through the gamma curve: eases at both ends and fades evenly to
+    // the eye, without the visible steps of a linear ramp at the dim end
+    uint8_t level = Lut_Gamma8(Lut_Sin8(effectState.breathe.phase >> 8));
+    uint8_t percent = 50 + Fixed_Math_Scale8(150, level);   // 50% .. 200% of base
+
+    // Calculate brightness as percentage of base brightness,
+    // the logo itself only has to be drawn once
+    globalBrightness = Fixed_Math_Percent8(baseBrightness, percent);
+    if (logoNeedsRender) {
+        WS2812B_RenderLogo();
+        logoNeedsRender = 0;
     }
-
-    // Calculate brightness as percentage of base brightness
-    globalBrightness = (baseBrightness * breathBrightness) / 100;
-    WS2812B_SetLogoColors();
+    WS2812B_SendToLEDs();
 }
 
 void WS2812B_SparkleEffect(void)
 {
-    static uint32_t lastSparkle = 0;
-    static uint16_t sparklePixel = 0;
-    static uint8_t sparkleState = 0;
-
-    if (HAL_GetTick() - lastSparkle < 150) return;
-    lastSparkle = HAL_GetTick();
-
     globalBrightness = baseBrightness;
 
-    if (sparkleState == 0) {
-        WS2812B_SetLogoColors();
-        sparklePixel = W_START + ws_random_byte(W_END - W_START + 1);
-        currentColors[sparklePixel] = WS2812B_Color(255, 255, 255);
-        sparkleState = 1;
-    } else {
-        WS2812B_SetLogoColors();
-        sparkleState = 0;
+    // Each step toggles the sparkle, a new one lands somewhere else in the W
+    for (uint16_t step = 0; step < effectSteps; step++) {
+        effectState.sparkle.lit = !effectState.sparkle.lit;
+        if (effectState.sparkle.lit) {
+            effectState.sparkle.pixel = W_START + ws_random_byte(W_END - W_START + 1);
+        }
+    }
+
+    // Redrawing the logo under an unmoved sparkle would mark it dirty and
+    // send an identical frame
+    if (effectSteps != 0) {
+        WS2812B_RenderLogo();
+        if (effectState.sparkle.lit) {
+            WS2812B_SetPixel(effectState.sparkle.pixel, WS2812B_Color(255, 255, 255));
+        }
     }
 
     WS2812B_SendToLEDs();
 }
 
+static void WS2812B_WaveInit(void)
+{
+    effectState.wave.pos = W_START;
+}
+
 void WS2812B_WaveEffect(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint16_t wavePos = W_START;
-    static uint8_t waveSection = 0;
+    globalBrightness = baseBrightness;
 
-    if (HAL_GetTick() - lastUpdate < 80) return;
-    lastUpdate = HAL_GetTick();
+    if (effectSteps == 0) {     // Nothing moved since the last frame
+        WS2812B_SendToLEDs();
+        return;
+    }
 
-    globalBrightness = baseBrightness;
-    WS2812B_SetLogoColors();
+    WS2812B_RenderLogo();
 
-    if (waveSection == 0) {
-        currentColors[wavePos] = WS2812B_Color(255, 150, 200);
-        wavePos++;
-        if (wavePos > W_END) {
-            wavePos = R_START;
-            waveSection = 1;
-        }
+    if (effectState.wave.section == 0) {
+        WS2812B_SetPixel(effectState.wave.pos, WS2812B_Color(255, 150, 200));
     } else {
-        currentColors[wavePos] = WS2812B_Color(255, 0, 100);
-        wavePos++;
-        if (wavePos > R_END) {
-            wavePos = W_START;
-            waveSection = 0;
+        WS2812B_SetPixel(effectState.wave.pos, WS2812B_Color(255, 0, 100));
+    }
+
+    for (uint16_t step = 0; step < effectSteps; step++) {
+        effectState.wave.pos++;
+        if (effectState.wave.section == 0 && effectState.wave.pos > W_END) {
+            effectState.wave.pos = R_START;
+            effectState.wave.section = 1;
+        } else if (effectState.wave.section == 1 && effectState.wave.pos > R_END) {
+            effectState.wave.pos = W_START;
+            effectState.wave.section = 0;
         }
     }
 
@@ -221,83 +767,75 @@ void WS2812B_WaveEffect(void)
 
 void WS2812B_PulseEffect(void)
 {
-    static uint32_t lastPulse = 0;
-    static uint8_t pulseState = 0;
-
-    if (HAL_GetTick() - lastPulse < 400) return;
-    lastPulse = HAL_GetTick();
+    // Every step flips between high and base, an even number cancels out
+    if (effectSteps & 1) {
+        effectState.pulse.high = !effectState.pulse.high;
+    }
 
-    if (pulseState == 0) {
-        globalBrightness = baseBrightness * 2;  // 200% of base brightness
-        if (globalBrightness > 255) globalBrightness = 255;  // Cap at max
-        WS2812B_SetLogoColors();
-        pulseState = 1;
+    if (effectState.pulse.high) {
+        globalBrightness = Fixed_Math_Percent8(baseBrightness, 200);  // 200% of base, capped at max
     } else {
         globalBrightness = baseBrightness;  // Back to base brightness
-        WS2812B_SetLogoColors();
-        pulseState = 0;
     }
+
+    if (logoNeedsRender) {
+        WS2812B_RenderLogo();
+        logoNeedsRender = 0;
+    }
+    WS2812B_SendToLEDs();
 }
 
 void WS2812B_RainbowEffect(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint8_t rainbowStep = 0;
-
-    if (HAL_GetTick() - lastUpdate < 60) return;
-    lastUpdate = HAL_GetTick();
-
     globalBrightness = baseBrightness;
 
     for(uint16_t i = 0; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Wheel((i + rainbowStep) & 255);
+        WS2812B_SetPixel(i, Lut_Hue8((i + effectState.rainbow.step) & 255));
     }
 
     WS2812B_SendToLEDs();
-    rainbowStep += 3;
+    effectState.rainbow.step += 3 * effectSteps;
 }
 
-void WS2812B_CometEffect(void)
+static void WS2812B_CometInit(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint16_t cometPos = W_START;
-    static uint8_t direction = 1;
-
-    if (HAL_GetTick() - lastUpdate < 80) return;
-    lastUpdate = HAL_GetTick();
+    effectState.comet.pos = W_START;
+    effectState.comet.forward = 1;
+}
 
+void WS2812B_CometEffect(void)
+{
     globalBrightness = baseBrightness;
 
     // Keep background
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Color(30, 30, 150);
-    }
-
-    // Fade trail
-    for(uint16_t i = W_START; i <= R_END; i++) {
-        uint32_t color = currentColors[i];
-        uint8_t r = ((color >> 16) & 0xFF) * 0.85;
-        uint8_t g = ((color >> 8) & 0xFF) * 0.85;
-        uint8_t b = (color & 0xFF) * 0.85;
-        currentColors[i] = WS2812B_Color(r, g, b);
+        WS2812B_SetPixel(i, WS2812B_Color(30, 30, 150));
     }
 
-    if(cometPos >= W_START && cometPos <= R_END) {
-        currentColors[cometPos] = WS2812B_Color(255, 255, 255);
-    }
+    // The trail fades once per step, so catching up draws the steps in between
+    for(uint16_t step = 0; step < effectSteps; step++) {
+        // Fade trail, pixels are full scale so this is the only dimming per step
+        for(uint16_t i = W_START; i <= R_END; i++) {
+            WS2812B_SetPixel(i, Fixed_Math_ScaleColor(currentColors[i], COMET_FADE));
+        }
 
-    if(direction) {
-        cometPos++;
-        if(cometPos > R_END) {
-            direction = 0;
-            cometPos = R_END;
+        if(effectState.comet.pos <= R_END) {
+            WS2812B_SetPixel(effectState.comet.pos, WS2812B_Color(255, 255, 255));
         }
-    } else {
-        if(cometPos > W_START) {
-            cometPos--;
+
+        if(effectState.comet.forward) {
+            effectState.comet.pos++;
+            if(effectState.comet.pos > R_END) {
+                effectState.comet.forward = 0;
+                effectState.comet.pos = R_END;
+            }
         } else {
-            direction = 1;
-            cometPos = W_START;
+            if(effectState.comet.pos > W_START) {
+                effectState.comet.pos--;
+            } else {
+                effectState.comet.forward = 1;
+                effectState.comet.pos = W_START;
+            }
         }
     }
 
@@ -306,96 +844,96 @@ void WS2812B_CometEffect(void)
 
 void WS2812B_FillEffect(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint8_t fillPos = 0;
-    static uint8_t fillState = 0;
-
-    if (HAL_GetTick() - lastUpdate < 100) return;
-    lastUpdate = HAL_GetTick();
-
     globalBrightness = baseBrightness;
 
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Color(30, 30, 150);
+        WS2812B_SetPixel(i, WS2812B_Color(30, 30, 150));
     }
 
-    switch(fillState) {
-        case 0: // Fill W section
-            if(fillPos < R_START) {
-                currentColors[W_START + fillPos] = WS2812B_Color(255, 0, 100);
-                fillPos++;
-            } else {
-                fillState = 1;
-                fillPos = 0;
-            }
-            break;
-
-        case 1: // Fill R section
-            if(fillPos <= (R_END - R_START)) {
-                currentColors[R_START + fillPos] = WS2812B_Color(255, 255, 255);
-                fillPos++;
-            } else {
-                fillState = 2;
-                fillPos = 0;
-            }
-            break;
-
-        case 2: // Empty all
-            if(fillPos <= R_END) {
-                currentColors[W_START + fillPos] = WS2812B_Color(0, 0, 0);
-                fillPos++;
-            } else {
-                fillState = 0;
-                fillPos = 0;
-            }
-            break;
+    for(uint16_t step = 0; step < effectSteps; step++) {
+        switch(effectState.fill.stage) {
+            case 0: // Fill W section
+                if(effectState.fill.pos < R_START) {
+                    WS2812B_SetPixel(W_START + effectState.fill.pos, WS2812B_Color(255, 0, 100));
+                    effectState.fill.pos++;
+                } else {
+                    effectState.fill.stage = 1;
+                    effectState.fill.pos = 0;
+                }
+                break;
+
+            case 1: // Fill R section
+                if(effectState.fill.pos <= (R_END - R_START)) {
+                    WS2812B_SetPixel(R_START + effectState.fill.pos, WS2812B_Color(255, 255, 255));
+                    effectState.fill.pos++;
+                } else {
+                    effectState.fill.stage = 2;
+                    effectState.fill.pos = 0;
+                }
+                break;
+
+            case 2: // Empty all
+                if(effectState.fill.pos <= R_END) {
+                    WS2812B_SetPixel(W_START + effectState.fill.pos, WS2812B_Color(0, 0, 0));
+                    effectState.fill.pos++;
+                } else {
+                    effectState.fill.stage = 0;
+                    effectState.fill.pos = 0;
+                }
+                break;
+        }
     }
 
     WS2812B_SendToLEDs();
 }
 
-void WS2812B_ScannerEffect(void)
+static void WS2812B_ScannerInit(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint16_t scanPos = W_START;
-    static uint8_t direction = 1;
-    static uint8_t scanWidth = 3;
-
-    if (HAL_GetTick() - lastUpdate < 50) return;
-    lastUpdate = HAL_GetTick();
+    effectState.scanner.pos = W_START;
+    effectState.scanner.forward = 1;
+}
 
+void WS2812B_ScannerEffect(void)
+{
     globalBrightness = baseBrightness;
 
+    if(effectSteps == 0) {      // Nothing moved since the last frame
+        WS2812B_SendToLEDs();
+        return;
+    }
+
     // Clear W and R sections
     for(int i = W_START; i <= R_END; i++) {
-        currentColors[i] = WS2812B_Color(0, 0, 0);
+        WS2812B_SetPixel(i, WS2812B_Color(0, 0, 0));
     }
 
     // Keep background
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Color(30, 30, 150);
+        WS2812B_SetPixel(i, WS2812B_Color(30, 30, 150));
     }
 
     // Create scanner beam
-    for(uint8_t i = 0; i < scanWidth; i++) {
-        uint16_t pos = scanPos + i;
-        if(pos >= W_START && pos <= R_END) {
+    for(uint8_t i = 0; i < SCANNER_WIDTH; i++) {
+        uint16_t pos = effectState.scanner.pos + i;
+        if(pos <= R_END) {
             uint8_t brightness = 255 - (i * 80);
-            currentColors[pos] = WS2812B_Color(brightness, 0, 0);
+            WS2812B_SetPixel(pos, WS2812B_Color(brightness, 0, 0));
         }
     }
 
     // Move scanner
-    if(direction) {
-        scanPos++;
-        if(scanPos >= (R_END - scanWidth + 1)) {
-            direction = 0;
-        }
-    } else {
-        if(scanPos > W_START) {
-            scanPos--;
+    for(uint16_t step = 0; step < effectSteps; step++) {
+        if(effectState.scanner.forward) {
+            effectState.scanner.pos++;
+            if(effectState.scanner.pos >= (R_END - SCANNER_WIDTH + 1)) {
+                effectState.scanner.forward = 0;
+            }
         } else {
-            direction = 1;
+            if(effectState.scanner.pos > W_START) {
+                effectState.scanner.pos--;
+            } else {
+                effectState.scanner.forward = 1;
+            }
         }
     }
 
@@ -404,164 +942,188 @@ void WS2812B_ScannerEffect(void)
 
 void WS2812B_ColorShiftEffect(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint8_t hue = 0;
-
-    if (HAL_GetTick() - lastUpdate < 40) return;
-    lastUpdate = HAL_GetTick();
+    uint8_t hue = effectState.colorShift.hue;
 
     globalBrightness = baseBrightness;
 
     for(int i = W_START; i <= W_END; i++) {
-        currentColors[i] = WS2812B_Wheel(hue);
+        WS2812B_SetPixel(i, Lut_Hue8(hue));
     }
 
     for(int i = R_START; i <= R_END; i++) {
-        currentColors[i] = WS2812B_Wheel(hue + 60);
+        WS2812B_SetPixel(i, Lut_Hue8(hue + 60));
     }
 
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Wheel(hue + 120);
+        WS2812B_SetPixel(i, Lut_Hue8(hue + 120));
     }
 
-    hue += 2;
+    effectState.colorShift.hue = hue + 2 * effectSteps;
     WS2812B_SendToLEDs();
 }
 
 void WS2812B_StrobeEffect(void)
 {
-    static uint32_t lastUpdate = 0;
-    static uint8_t strobeState = 0;
-    static uint8_t strobeCount = 0;
+    globalBrightness = Fixed_Math_Percent8(baseBrightness, 200);  // Capped at max
 
-    if (HAL_GetTick() - lastUpdate < 150) return;
-    lastUpdate = HAL_GetTick();
-
-    strobeCount++;
-    globalBrightness = baseBrightness * 2;
-    if (globalBrightness > 255) globalBrightness = 255;  // Cap at max
-
-    if(strobeState == 0) {
+    if(effectState.strobe.section == 0) {
         // Flash W section only
         for(int i = W_START; i < R_START; i++) {
-            currentColors[i] = WS2812B_Color(255, 0, 100);
+            WS2812B_SetPixel(i, WS2812B_Color(255, 0, 100));
         }
         for(int i = R_START; i <= R_END; i++) {
-            currentColors[i] = WS2812B_Color(0, 0, 0);
+            WS2812B_SetPixel(i, WS2812B_Color(0, 0, 0));
         }
     } else {
         // Flash R section only
         for(int i = W_START; i < R_START; i++) {
-            currentColors[i] = WS2812B_Color(0, 0, 0);
+            WS2812B_SetPixel(i, WS2812B_Color(0, 0, 0));
         }
         for(int i = R_START; i <= R_END; i++) {
-            currentColors[i] = WS2812B_Color(255, 255, 255);
+            WS2812B_SetPixel(i, WS2812B_Color(255, 255, 255));
         }
     }
 
     // Keep background dim
     for(int i = R_END + 1; i < LED_COUNT; i++) {
-        currentColors[i] = WS2812B_Color(10, 10, 50);
+        WS2812B_SetPixel(i, WS2812B_Color(10, 10, 50));
     }
 
-    if(strobeCount >= 4) {
-        strobeState = 1 - strobeState;
-        strobeCount = 0;
+    // Four steps on each section
+    for(uint16_t step = 0; step < effectSteps; step++) {
+        effectState.strobe.count++;
+        if(effectState.strobe.count >= 4) {
+            effectState.strobe.section = 1 - effectState.strobe.section;
+            effectState.strobe.count = 0;
+        }
     }
 
     WS2812B_SendToLEDs();
 }
 
-uint32_t WS2812B_Wheel(uint8_t wheelPos)
+/* Effect registry, in effect_mode_t order. Adding an effect takes a mode,
+ * an entry here and, if it keeps state, a struct in effectState. render()
+ * draws the current state and moves it on by effectSteps, which may be 0. */
+static const ws2812b_effect_t effects[MODE_COUNT] = {
+    [MODE_STATIC_LOGO] = { WS2812B_StaticLogoInit, WS2812B_StaticLogoEffect, 0   },
+    [MODE_BREATHE]     = { WS2812B_BreatheInit,    WS2812B_BreatheEffect,    30  },
+    [MODE_SPARKLE]     = { NULL,                   WS2812B_SparkleEffect,    150 },
+    [MODE_WAVE]        = { WS2812B_WaveInit,       WS2812B_WaveEffect,       80  },
+    [MODE_PULSE]       = { NULL,                   WS2812B_PulseEffect,      400 },
+    [MODE_RAINBOW]     = { NULL,                   WS2812B_RainbowEffect,    60  },
+    [MODE_COMET]       = { WS2812B_CometInit,      WS2812B_CometEffect,      80  },
+    [MODE_FILL]        = { NULL,                   WS2812B_FillEffect,       100 },
+    [MODE_SCANNER]     = { WS2812B_ScannerInit,    WS2812B_ScannerEffect,    50  },
+    [MODE_COLOR_SHIFT] = { NULL,                   WS2812B_ColorShiftEffect, 40  },
+    [MODE_STROBE]      = { NULL,                   WS2812B_StrobeEffect,     150 },
+};
+
+/* 0 = no frame clock, the effect is only redrawn when something changes */
+static uint16_t WS2812B_FramePeriod(const ws2812b_effect_t *effect)
 {
-    wheelPos = 255 - wheelPos;
-    if(wheelPos < 85) {
-        return WS2812B_Color(255 - wheelPos * 3, 0, wheelPos * 3);
+    uint16_t period = effect->stepMs;
+
+    if (period != 0 && framePeriodMs != 0) {
+        period = framePeriodMs;
     }
-    if(wheelPos < 170) {
-        wheelPos -= 85;
-        return WS2812B_Color(0, wheelPos * 3, 255 - wheelPos * 3);
+#if WS2812B_DITHER
+    // The carried error only averages out over a steady stream of frames
+    if (period == 0 || period > WS2812B_DITHER_PERIOD_MS) {
+        period = WS2812B_DITHER_PERIOD_MS;
     }
-    wheelPos -= 170;
-    return WS2812B_Color(wheelPos * 3, 255 - wheelPos * 3, 0);
+#endif
+    return period;
 }
 
 void WS2812B_RunEffect(effect_mode_t mode)
 {
+    static effect_mode_t lastMode = MODE_COUNT;  // Initialize to invalid mode
 
-	static effect_mode_t lastMode = MODE_COUNT;  // Initialize to invalid mode
-
-	// Check if mode has changed
-	    if (mode != lastMode) {
-	        // Mode changed - set flag to update static logo if needed
-	        if (mode == MODE_STATIC_LOGO) {
-	            staticLogoNeedsUpdate = 1;
-	        }
-	        lastMode = mode;
-	    }
-
-	    switch(mode) {
-	            case MODE_STATIC_LOGO:
-	                WS2812B_StaticLogoEffect();
-	                break;
-
-	            case MODE_BREATHE:
-	                WS2812B_BreatheEffect();
-	                break;
-
-	            case MODE_SPARKLE:
-	                WS2812B_SparkleEffect();
-	                break;
-
-	            case MODE_WAVE:
-	                WS2812B_WaveEffect();
-	                break;
-
-	            case MODE_PULSE:
-	                WS2812B_PulseEffect();
-	                break;
+    // Fallback to static logo for invalid modes
+    if (mode >= MODE_COUNT) {
+        mode = MODE_STATIC_LOGO;
+    }
+    const ws2812b_effect_t *effect = &effects[mode];
+    uint16_t periodMs = WS2812B_FramePeriod(effect);
+
+    // A new effect always starts from the beginning
+    if (mode != lastMode) {
+        memset(&effectState, 0, sizeof(effectState));
+        logoNeedsRender = 1;
+        if (effect->init != NULL) {
+            effect->init();
+        }
+        Animation_Start(&effectAnimation, effect->stepMs);
+        lastMode = mode;
+        clockRestartPending = 1;
+    }
 
-	            case MODE_RAINBOW:
-	                WS2812B_RainbowEffect();
-	                break;
+    // Restarting the frame clock makes the first frame due right away
+    if (clockRestartPending) {
+        clockRestartPending = 0;
+        refreshPending = 0;
+        Frame_Scheduler_Start(periodMs * 1000);
+    }
 
-	            case MODE_COMET:
-	                WS2812B_CometEffect();
-	                break;
+    uint8_t inSlot = 0;
+    if (refreshPending) {
+        // Extra frame outside the slots that does not move the animation:
+        // the slots and the half-step phase stay where they were
+        refreshPending = 0;
+        effectSteps = 0;
+    } else if (periodMs != 0 && !Frame_Scheduler_FrameDue()) {
+        // Animated effects render once per frame slot of the scheduler
+        return;
+    } else {
+        // The steps follow elapsed time, whatever the frame rate
+        inSlot = (periodMs != 0);
+        effectSteps = Animation_Advance(&effectAnimation);
+    }
 
-	            case MODE_FILL:
-	                WS2812B_FillEffect();
-	                break;
+    Telemetry_FrameStart(mode);
 
-	            case MODE_SCANNER:
-	                WS2812B_ScannerEffect();
-	                break;
+#if WS2812B_BENCHMARK
+    uint32_t start = WS2812B_CycleStamp();
+#endif
 
-	            case MODE_COLOR_SHIFT:
-	                WS2812B_ColorShiftEffect();
-	                break;
+    effect->render();
 
-	            case MODE_STROBE:
-	                WS2812B_StrobeEffect();
-	                break;
+    if (inSlot) {
+        Frame_Scheduler_FrameRendered();
+    }
 
-	            case MODE_COUNT:
-	            default:
-	                // Fallback to static logo for invalid modes
-	                WS2812B_StaticLogoEffect();
-	                break;
+#if WS2812B_BENCHMARK
+    uint32_t cycles = WS2812B_CycleStamp() - start;
+    if (cycles > effectMaxCycles[mode]) {
+        effectMaxCycles[mode] = cycles;
     }
+#endif
 }
 
-// Function to trigger static logo update (call when brightness changes)
-void WS2812B_TriggerStaticLogoUpdate(void)
+/* Show a brightness change now: the static logo is sent again and an
+ * animated effect sends its current pixels at once, without waiting for its
+ * next frame slot and without restarting the frame clock */
+void WS2812B_RefreshEffect(void)
 {
     staticLogoNeedsUpdate = 1;
+    refreshPending = 1;
+}
+
+/* Render animated effects every periodMs instead of once per animation step.
+ * Trades smoothness for power or locks to a camera; the animation speed
+ * stays the same. 0 restores one frame per step. */
+void WS2812B_SetFramePeriod(uint16_t periodMs)
+{
+    if (periodMs != framePeriodMs) {
+        framePeriodMs = periodMs;
+        clockRestartPending = 1;
+    }
 }
 
 uint32_t ws_random_byte(uint32_t max)
 {
     static uint32_t seed = 1;
     seed = seed * 1664525 + 1013904223;
-    return (seed >> 16) % max;
+    // Map the top 16 bits onto 0..max-1 with a multiply instead of a modulo
+    return ((seed >> 16) * max) >> 16;
 }
@@ -5,33 +5,60 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Core/Src/animation.c \
+../Core/Src/button.c \
+../Core/Src/event_queue.c \
+../Core/Src/fixed_math.c \
 ../Core/Src/flash_storage.c \
+../Core/Src/frame_scheduler.c \
+../Core/Src/low_power.c \
+../Core/Src/lut.c \
+../Core/Src/lut_tables.c \
 ../Core/Src/main.c \
 ../Core/Src/stm32f0xx_hal_msp.c \
 ../Core/Src/stm32f0xx_it.c \
 ../Core/Src/syscalls.c \
 ../Core/Src/sysmem.c \
 ../Core/Src/system_stm32f0xx.c \
+../Core/Src/telemetry.c \
 ../Core/Src/ws2812b.c 
 
 OBJS += \
+./Core/Src/animation.o \
+./Core/Src/button.o \
+./Core/Src/event_queue.o \
+./Core/Src/fixed_math.o \
 ./Core/Src/flash_storage.o \
+./Core/Src/frame_scheduler.o \
+./Core/Src/low_power.o \
+./Core/Src/lut.o \
+./Core/Src/lut_tables.o \
 ./Core/Src/main.o \
 ./Core/Src/stm32f0xx_hal_msp.o \
 ./Core/Src/stm32f0xx_it.o \
 ./Core/Src/syscalls.o \
 ./Core/Src/sysmem.o \
 ./Core/Src/system_stm32f0xx.o \
+./Core/Src/telemetry.o \
 ./Core/Src/ws2812b.o 
 
 C_DEPS += \
+./Core/Src/animation.d \
+./Core/Src/button.d \
+./Core/Src/event_queue.d \
+./Core/Src/fixed_math.d \
 ./Core/Src/flash_storage.d \
+./Core/Src/frame_scheduler.d \
+./Core/Src/low_power.d \
+./Core/Src/lut.d \
+./Core/Src/lut_tables.d \
 ./Core/Src/main.d \
 ./Core/Src/stm32f0xx_hal_msp.d \
 ./Core/Src/stm32f0xx_it.d \
 ./Core/Src/syscalls.d \
 ./Core/Src/sysmem.d \
 ./Core/Src/system_stm32f0xx.d \
+./Core/Src/telemetry.d \
 ./Core/Src/ws2812b.d 
 
 
@@ -42,7 +69,7 @@ Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/flash_storage.cyclo ./Core/Src/flash_storage.d ./Core/Src/flash_storage.o ./Core/Src/flash_storage.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/stm32f0xx_hal_msp.cyclo ./Core/Src/stm32f0xx_hal_msp.d ./Core/Src/stm32f0xx_hal_msp.o ./Core/Src/stm32f0xx_hal_msp.su ./Core/Src/stm32f0xx_it.cyclo ./Core/Src/stm32f0xx_it.d ./Core/Src/stm32f0xx_it.o ./Core/Src/stm32f0xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f0xx.cyclo ./Core/Src/system_stm32f0xx.d ./Core/Src/system_stm32f0xx.o ./Core/Src/system_stm32f0xx.su ./Core/Src/ws2812b.cyclo ./Core/Src/ws2812b.d ./Core/Src/ws2812b.o ./Core/Src/ws2812b.su
+	-$(RM) ./Core/Src/animation.cyclo ./Core/Src/animation.d ./Core/Src/animation.o ./Core/Src/animation.su ./Core/Src/button.cyclo ./Core/Src/button.d ./Core/Src/button.o ./Core/Src/button.su ./Core/Src/event_queue.cyclo ./Core/Src/event_queue.d ./Core/Src/event_queue.o ./Core/Src/event_queue.su ./Core/Src/fixed_math.cyclo ./Core/Src/fixed_math.d ./Core/Src/fixed_math.o ./Core/Src/fixed_math.su ./Core/Src/flash_storage.cyclo ./Core/Src/flash_storage.d ./Core/Src/flash_storage.o ./Core/Src/flash_storage.su ./Core/Src/frame_scheduler.cyclo ./Core/Src/frame_scheduler.d ./Core/Src/frame_scheduler.o ./Core/Src/frame_scheduler.su ./Core/Src/low_power.cyclo ./Core/Src/low_power.d ./Core/Src/low_power.o ./Core/Src/low_power.su ./Core/Src/lut.cyclo ./Core/Src/lut.d ./Core/Src/lut.o ./Core/Src/lut.su ./Core/Src/lut_tables.cyclo ./Core/Src/lut_tables.d ./Core/Src/lut_tables.o ./Core/Src/lut_tables.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/stm32f0xx_hal_msp.cyclo ./Core/Src/stm32f0xx_hal_msp.d ./Core/Src/stm32f0xx_hal_msp.o ./Core/Src/stm32f0xx_hal_msp.su ./Core/Src/stm32f0xx_it.cyclo ./Core/Src/stm32f0xx_it.d ./Core/Src/stm32f0xx_it.o ./Core/Src/stm32f0xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f0xx.cyclo ./Core/Src/system_stm32f0xx.d ./Core/Src/system_stm32f0xx.o ./Core/Src/system_stm32f0xx.su ./Core/Src/telemetry.cyclo ./Core/Src/telemetry.d ./Core/Src/telemetry.o ./Core/Src/telemetry.su ./Core/Src/ws2812b.cyclo ./Core/Src/ws2812b.d ./Core/Src/ws2812b.o ./Core/Src/ws2812b.su
 
 .PHONY: clean-Core-2f-Src
 
@@ -0,0 +1,84 @@
+/**
+******************************************************************************
+* @file           : cm0_emu.h
+* @brief          : ARMv6-M (Cortex-M0) instruction set emulator with cycle counts
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef HOST_CM0_EMU_H_
+#define HOST_CM0_EMU_H_
+
+#include <stdint.h>
+
+/* Runs Thumb code from a firmware image and counts core cycles by the
+ * Cortex-M0 TRM instruction timings (1-cycle multiplier, as on the
+ * STM32F0). Flash wait states are modelled on top: each taken branch
+ * refetches from flash and each data read from flash waits, sequential
+ * fetches are covered by the prefetch buffer. No exceptions: interrupt
+ * work is done by hooks calling back into the image with Cm0_Call. */
+#define CM0_FLASH_BASE      0x08000000U
+#define CM0_FLASH_SIZE      (1024 * 1024)
+#define CM0_RAM_BASE        0x20000000U
+#define CM0_RAM_SIZE        (256 * 1024)
+#define CM0_APB_BASE        0x40000000U
+#define CM0_APB_SIZE        0x00030000U     // APB and AHB1 peripherals, CRC included
+#define CM0_GPIO_BASE       0x48000000U
+#define CM0_GPIO_SIZE       0x00002000U
+#define CM0_SCS_BASE        0xE000E000U     // SysTick, NVIC, SCB
+#define CM0_SCS_SIZE        0x00001000U
+#define CM0_RETURN          0xFFFFFFF0U     // LR of a Cm0_Call, reaching it ends the call
+#define CM0_MAX_HOOKS       16
+
+typedef struct cm0 cm0_t;
+
+/* Replaces the function at an address: runs instead of it, r0 is the result */
+typedef uint32_t (*cm0_hook_t)(cm0_t *cpu, void *context);
+
+struct cm0 {
+    uint32_t r[16];
+    uint8_t n, z, c, v;
+    uint8_t primask;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint8_t flashWaitStates;
+    const char *fault;          // Set when the code did something the M0 faults on
+    uint8_t *flash;
+    uint8_t *ram;
+    uint8_t *apb;
+    uint8_t *gpio;
+    uint8_t *scs;
+    uint32_t crc;               // CRC unit data register
+    struct {
+        uint32_t address;
+        cm0_hook_t hook;
+        void *context;
+    } hooks[CM0_MAX_HOOKS];
+    uint8_t hookCount;
+};
+
+/* Function prototypes */
+cm0_t* Cm0_Create(void);
+void Cm0_Destroy(cm0_t *cpu);
+uint8_t* Cm0_Memory(cm0_t *cpu, uint32_t address, uint32_t size);
+void Cm0_Hook(cm0_t *cpu, uint32_t address, cm0_hook_t hook, void *context);
+uint32_t Cm0_Call(cm0_t *cpu, uint32_t address, const uint32_t *args, uint8_t argCount, uint64_t *cycles);
+uint32_t Cm0_Read32(cm0_t *cpu, uint32_t address);
+void Cm0_Write32(cm0_t *cpu, uint32_t address, uint32_t value);
+void Cm0_Write16(cm0_t *cpu, uint32_t address, uint16_t value);
+void Cm0_Write8(cm0_t *cpu, uint32_t address, uint8_t value);
+
+#endif /* HOST_CM0_EMU_H_ */
@@ -0,0 +1,74 @@
+/**
+******************************************************************************
+* @file           : host.h
+* @brief          : virtual hardware behind the host build of the firmware
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef HOST_HOST_H_
+#define HOST_HOST_H_
+
+#include "main.h"
+
+/* The firmware runs unmodified on a virtual clock: time only moves when the
+ * firmware waits for it (HAL_GetTick, WFI, a flash operation). main() runs as
+ * a coroutine and hands control back to the host whenever it goes idle past
+ * the time given to Host_Run. */
+#define HOST_HCLK_PER_US        48      // TIM3 clock and SysTick run at HCLK
+#define HOST_GETTICK_COST_US    1       // Every HAL_GetTick call, so busy-waits end
+#define HOST_FLASH_BASE         0x08000000U
+#define HOST_FLASH_SIZE         0x4000U
+#define HOST_FLASH_ERASE_US     30000   // Page erase, datasheet typical
+#define HOST_FLASH_WORD_US      106     // Two halfwords of 53 us each
+#define HOST_RESET_CLOCKS       (50 * HOST_HCLK_PER_US) // Line low this long ends a captured frame
+#define HOST_CAPTURE_MAX        (1024 * 24 + 64)
+
+/* One TIM3 period on the data line in TIM3 clocks. Periods with the line
+ * held low are merged, so a reset shows up as one long entry. A frame
+ * starts with the low time since the previous frame's last bit and ends
+ * once the line has been low for HOST_RESET_CLOCKS. */
+typedef struct {
+    uint16_t high;
+    uint32_t period;
+} host_pulse_t;
+
+typedef void (*host_frame_hook_t)(const host_pulse_t *pulses, uint32_t count);
+typedef void (*host_submit_hook_t)(void);   // The DMA is about to start sending a frame
+
+typedef struct {
+    uint32_t erases;
+    uint32_t words;
+} host_flash_stats_t;
+
+/* Function prototypes */
+void Host_Boot(void);
+void Host_Run(uint32_t untilUs);
+uint32_t Host_Micros(void);
+void Host_SetButton(uint8_t pressed);
+uint32_t Host_GetFrameCount(void);
+const host_pulse_t* Host_GetFrame(uint32_t *count);
+void Host_SetFrameHook(host_frame_hook_t hook);
+void Host_SetSubmitHook(host_submit_hook_t hook);
+uint8_t* Host_Flash(uint32_t address);
+void Host_FlashErase(void);
+void Host_StoreSettings(uint8_t mode, uint8_t brightnessLevel);
+const host_flash_stats_t* Host_GetFlashStats(void);
+
+/* main() of main.c, renamed by the host makefile */
+int Firmware_Main(void);
+
+#endif /* HOST_HOST_H_ */
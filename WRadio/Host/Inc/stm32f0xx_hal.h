@@ -0,0 +1,330 @@
+/**
+******************************************************************************
+* @file           : stm32f0xx_hal.h
+* @brief          : host stand-in for the STM32F0 HAL and CMSIS headers
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+
+#ifndef HOST_STM32F0XX_HAL_H_
+#define HOST_STM32F0XX_HAL_H_
+
+/* Only what the Core sources use. Peripheral registers are plain memory,
+ * hal_shim.c plays the hardware behind them while the virtual clock runs. */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+/* CMSIS ---------------------------------------------------------------------*/
+#define __IO            volatile
+#define __weak          __attribute__((weak))
+#define __ALIGNED(x)    __attribute__((aligned(x)))
+
+extern uint32_t hostPrimask;
+void Host_DispatchInterrupts(void);
+
+/* Unmasking runs whatever became pending meanwhile, as on the core */
+static inline void __disable_irq(void) { hostPrimask = 1; }
+static inline void __enable_irq(void) { hostPrimask = 0; Host_DispatchInterrupts(); }
+static inline uint32_t __get_PRIMASK(void) { return hostPrimask; }
+static inline void __set_PRIMASK(uint32_t primask)
+{
+    hostPrimask = primask;
+    if (!primask) Host_DispatchInterrupts();
+}
+static inline void __DMB(void) { __sync_synchronize(); }
+
+typedef struct {
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+    __IO uint32_t CALIB;
+} SysTick_Type;
+
+/* Registers -----------------------------------------------------------------*/
+typedef struct {
+    __IO uint32_t CR1;
+    __IO uint32_t DIER;
+    __IO uint32_t SR;
+    __IO uint32_t EGR;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t ARR;
+    __IO uint32_t CCR1;
+} TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t CCR;
+    __IO uint32_t CNDTR;
+    __IO uint32_t CPAR;
+    __IO uint32_t CMAR;
+} DMA_Channel_TypeDef;
+
+typedef struct {
+    __IO uint32_t ACR;
+    __IO uint32_t KEYR;
+    __IO uint32_t OPTKEYR;
+    __IO uint32_t SR;
+    __IO uint32_t CR;
+    __IO uint32_t AR;
+} FLASH_TypeDef;
+
+typedef struct {
+    __IO uint32_t DR;
+    __IO uint32_t IDR;
+    __IO uint32_t CR;
+    __IO uint32_t INIT;
+} CRC_TypeDef;
+
+typedef struct {
+    __IO uint32_t IDR;
+} GPIO_TypeDef;
+
+extern TIM_TypeDef hostTim3, hostTim16;
+extern DMA_Channel_TypeDef hostDma1Channel4;
+extern FLASH_TypeDef hostFlash;
+extern CRC_TypeDef hostCrc;
+extern GPIO_TypeDef hostGpioA;
+extern SysTick_Type hostSysTick;
+
+#define TIM3                (&hostTim3)
+#define TIM16               (&hostTim16)
+#define DMA1_Channel4       (&hostDma1Channel4)
+#define FLASH               (&hostFlash)
+#define CRC                 (&hostCrc)
+#define GPIOA               (&hostGpioA)
+#define SysTick             (&hostSysTick)
+
+#define TIM_DIER_UIE        0x0001U
+#define TIM_DIER_CC1IE      0x0002U
+#define TIM_DIER_CC1DE      0x0200U
+#define TIM_SR_UIF          0x0001U
+#define TIM_SR_CC1IF        0x0002U
+#define TIM_EGR_UG          0x0001U
+#define TIM_EGR_CC1G        0x0002U
+
+#define FLASH_CR_PG         0x0001U
+#define FLASH_CR_PER        0x0002U
+#define FLASH_CR_STRT       0x0040U
+#define FLASH_SR_BSY        0x0001U
+#define FLASH_SR_EOP        0x0020U
+#define FLASH_SR_PGERR      0x0000U     // RAM never fails to program, and SR is not write-1-to-clear here
+#define FLASH_SR_WRPERR     0x0000U
+
+#define CRC_CR_RESET        0x0001U
+
+/* HAL -----------------------------------------------------------------------*/
+typedef enum {
+    HAL_OK       = 0x00U,
+    HAL_ERROR    = 0x01U,
+    HAL_BUSY     = 0x02U,
+    HAL_TIMEOUT  = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0U,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+#define GPIO_PIN_0          ((uint16_t)0x0001U)
+
+typedef struct {
+    uint32_t Direction;
+    uint32_t PeriphInc;
+    uint32_t MemInc;
+    uint32_t PeriphDataAlignment;
+    uint32_t MemDataAlignment;
+    uint32_t Mode;
+    uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct {
+    DMA_Channel_TypeDef *Instance;
+    DMA_InitTypeDef Init;
+} DMA_HandleTypeDef;
+
+#define DMA_NORMAL          0x00000000U
+#define DMA_CIRCULAR        0x00000020U
+
+typedef struct {
+    uint32_t Prescaler;
+    uint32_t CounterMode;
+    uint32_t Period;
+    uint32_t ClockDivision;
+    uint32_t RepetitionCounter;
+    uint32_t AutoReloadPreload;
+} TIM_Base_InitTypeDef;
+
+typedef struct {
+    TIM_TypeDef *Instance;
+    TIM_Base_InitTypeDef Init;
+} TIM_HandleTypeDef;
+
+#define TIM_CHANNEL_1       0x00000000U
+#define TIM_IT_UPDATE       TIM_DIER_UIE
+#define TIM_IT_CC1          TIM_DIER_CC1IE
+#define TIM_DMA_CC1         TIM_DIER_CC1DE
+#define TIM_FLAG_UPDATE     TIM_SR_UIF
+
+#define __HAL_TIM_GET_COUNTER(__HANDLE__)           ((__HANDLE__)->Instance->CNT)
+#define __HAL_TIM_SET_COMPARE(__HANDLE__, __CHANNEL__, __COMPARE__) ((__HANDLE__)->Instance->CCR1 = (__COMPARE__))
+#define __HAL_TIM_SET_AUTORELOAD(__HANDLE__, __AUTORELOAD__) \
+  do{                                                    \
+    (__HANDLE__)->Instance->ARR = (__AUTORELOAD__);  \
+    (__HANDLE__)->Init.Period = (__AUTORELOAD__);    \
+  } while(0)
+#define __HAL_TIM_CLEAR_IT(__HANDLE__, __INTERRUPT__)   ((__HANDLE__)->Instance->SR &= ~(__INTERRUPT__))
+#define __HAL_TIM_GET_FLAG(__HANDLE__, __FLAG__)        (((__HANDLE__)->Instance->SR & (__FLAG__)) == (__FLAG__))
+#define __HAL_TIM_ENABLE_IT(__HANDLE__, __INTERRUPT__)  ((__HANDLE__)->Instance->DIER |= (__INTERRUPT__))
+#define __HAL_TIM_DISABLE_IT(__HANDLE__, __INTERRUPT__) ((__HANDLE__)->Instance->DIER &= ~(__INTERRUPT__))
+#define __HAL_TIM_ENABLE_DMA(__HANDLE__, __DMA__)       ((__HANDLE__)->Instance->DIER |= (__DMA__))
+#define __HAL_TIM_DISABLE_DMA(__HANDLE__, __DMA__)      ((__HANDLE__)->Instance->DIER &= ~(__DMA__))
+#define __HAL_DMA_GET_COUNTER(__HANDLE__)           ((__HANDLE__)->Instance->CNDTR)
+#define __HAL_RCC_CRC_CLK_ENABLE()                  do { } while(0)
+
+#define PWR_MAINREGULATOR_ON        0x00000000U
+#define PWR_LOWPOWERREGULATOR_ON    0x00000001U
+#define PWR_SLEEPENTRY_WFI          ((uint8_t)0x01U)
+#define PWR_STOPENTRY_WFI           ((uint8_t)0x01U)
+
+extern __IO uint32_t uwTick;
+extern uint32_t uwTickFreq;
+
+uint32_t HAL_GetTick(void);
+void HAL_Delay(uint32_t Delay);
+void HAL_SuspendTick(void);
+void HAL_ResumeTick(void);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length);
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Channel);
+HAL_StatusTypeDef HAL_FLASH_Unlock(void);
+HAL_StatusTypeDef HAL_FLASH_Lock(void);
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry);
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry);
+
+/* CubeMX initialisation, accepted and mostly ignored ------------------------*/
+typedef enum {
+    DMA1_Channel4_5_IRQn = 11,
+    EXTI0_1_IRQn         = 5
+} IRQn_Type;
+
+typedef struct {
+    uint32_t PLLState;
+    uint32_t PLLSource;
+    uint32_t PLLMUL;
+    uint32_t PREDIV;
+} RCC_PLLInitTypeDef;
+
+typedef struct {
+    uint32_t OscillatorType;
+    uint32_t HSIState;
+    uint32_t HSICalibrationValue;
+    RCC_PLLInitTypeDef PLL;
+} RCC_OscInitTypeDef;
+
+typedef struct {
+    uint32_t ClockType;
+    uint32_t SYSCLKSource;
+    uint32_t AHBCLKDivider;
+    uint32_t APB1CLKDivider;
+} RCC_ClkInitTypeDef;
+
+typedef struct {
+    uint32_t ClockSource;
+    uint32_t ClockPolarity;
+    uint32_t ClockPrescaler;
+    uint32_t ClockFilter;
+} TIM_ClockConfigTypeDef;
+
+typedef struct {
+    uint32_t MasterOutputTrigger;
+    uint32_t MasterSlaveMode;
+} TIM_MasterConfigTypeDef;
+
+typedef struct {
+    uint32_t OCMode;
+    uint32_t Pulse;
+    uint32_t OCPolarity;
+    uint32_t OCNPolarity;
+    uint32_t OCFastMode;
+    uint32_t OCIdleState;
+    uint32_t OCNIdleState;
+} TIM_OC_InitTypeDef;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+    uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+#define RCC_OSCILLATORTYPE_HSI          0x00000002U
+#define RCC_HSI_ON                      0x00000001U
+#define RCC_HSICALIBRATION_DEFAULT      0x10U
+#define RCC_PLL_ON                      0x00000002U
+#define RCC_PLLSOURCE_HSI               0x00000000U
+#define RCC_PLL_MUL12                   0x00280000U
+#define RCC_PREDIV_DIV1                 0x00000000U
+#define RCC_CLOCKTYPE_SYSCLK            0x00000001U
+#define RCC_CLOCKTYPE_HCLK              0x00000002U
+#define RCC_CLOCKTYPE_PCLK1             0x00000004U
+#define RCC_SYSCLKSOURCE_PLLCLK         0x00000002U
+#define RCC_SYSCLK_DIV1                 0x00000000U
+#define RCC_HCLK_DIV1                   0x00000000U
+#define FLASH_LATENCY_1                 0x00000001U
+
+#define TIM_COUNTERMODE_UP              0x00000000U
+#define TIM_CLOCKDIVISION_DIV1          0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_DISABLE  0x00000000U
+#define TIM_AUTORELOAD_PRELOAD_ENABLE   0x00000080U
+#define TIM_CLOCKSOURCE_INTERNAL        0x00000000U
+#define TIM_TRGO_RESET                  0x00000000U
+#define TIM_MASTERSLAVEMODE_DISABLE     0x00000000U
+#define TIM_OCMODE_PWM1                 0x00000060U
+#define TIM_OCPOLARITY_HIGH             0x00000000U
+#define TIM_OCFAST_DISABLE              0x00000000U
+
+#define GPIO_MODE_IT_RISING_FALLING     0x10310000U
+#define GPIO_NOPULL                     0x00000000U
+
+#define __HAL_RCC_DMA1_CLK_ENABLE()     do { } while(0)
+#define __HAL_RCC_GPIOA_CLK_ENABLE()    do { } while(0)
+
+HAL_StatusTypeDef HAL_Init(void);
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct);
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency);
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig);
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig);
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel);
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority);
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn);
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+
+/* Callbacks the shim raises from its interrupts, main.c routes them */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin);
+void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PWM_PulseFinishedHalfCpltCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim);
+void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim);
+
+#endif /* HOST_STM32F0XX_HAL_H_ */
@@ -0,0 +1,447 @@
+/**
+******************************************************************************
+* @file           : bench.c
+* @brief          : cycle counts of the firmware hot paths, run from the ARM image
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "cm0_emu.h"
+
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Runs the hot paths of a firmware image (the .elf the ARM build links) on
+ * the Cortex-M0 emulator and prints their cycles per call and per LED. Give
+ * it one image per LED_COUNT to see how the costs scale, see the makefile.
+ * The DMA start/stop and DMA init calls of the HAL are replaced by stubs:
+ * a started frame completes at once by running the firmware's own DMA
+ * callbacks, whose cycles are reported apart as interrupt cycles. Streaming
+ * images get their DMA interrupts one half at a time, each refill timed. */
+#define BENCH_CALLS         64
+#define BENCH_SCRATCH       (CM0_RAM_BASE + CM0_RAM_SIZE / 2)  // Far above the firmware's 4 KB of RAM
+#define BENCH_FRAME_MS      20                                  // uwTick step between effect frames
+#define BENCH_DRAIN_ROUNDS  4096
+#define BENCH_TIM3          0x40000400U                         // htim3.Instance, MX_TIM3_Init does not run here
+#define BENCH_TIM_DIER      0x0CU
+#define BENCH_TIM_DIER_UIE  0x0001U
+#define BENCH_DMA_CHANNEL4  0x40020044U                         // hdma_tim3_ch1_trig.Instance
+
+typedef struct {
+    uint8_t *file;
+    size_t fileSize;
+    const Elf32_Sym *symbols;
+    uint32_t symbolCount;
+    const char *names;
+} bench_image_t;
+
+typedef struct {
+    uint32_t calls;
+    uint64_t total;
+    uint64_t max;
+    uint64_t isr;
+} bench_result_t;
+
+typedef struct {
+    cm0_t *cpu;
+    bench_image_t image;
+    uint16_t ledCount;
+    uint8_t streaming;
+    uint64_t isrCycles;
+    bench_result_t refills;     // Streaming images: per DMA interrupt
+    uint32_t pulseFinished;
+    uint32_t pulseHalfFinished;
+    uint32_t latchElapsed;
+    uint32_t isBusy;
+    uint32_t uwTick;
+    uint32_t effectSteps;
+} bench_t;
+
+
+static const char *byteHelpers[] = {
+    "WS2812B_Wheel",
+    "Lut_Hue8",
+    "Lut_Sin8",
+    "Lut_Gamma8",
+};
+
+static const char *effects[] = {
+    "WS2812B_StaticLogoEffect",
+    "WS2812B_BreatheEffect",
+    "WS2812B_SparkleEffect",
+    "WS2812B_WaveEffect",
+    "WS2812B_PulseEffect",
+    "WS2812B_RainbowEffect",
+    "WS2812B_CometEffect",
+    "WS2812B_FillEffect",
+    "WS2812B_ScannerEffect",
+    "WS2812B_ColorShiftEffect",
+    "WS2812B_StrobeEffect",
+};
+
+static uint8_t Bench_Load(bench_t *bench, const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    const Elf32_Ehdr *header;
+
+    if(file == NULL) {
+        perror(path);
+        return 0;
+    }
+    fseek(file, 0, SEEK_END);
+    bench->image.fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    bench->image.file = malloc(bench->image.fileSize);
+    if(fread(bench->image.file, 1, bench->image.fileSize, file) != bench->image.fileSize) {
+        fclose(file);
+        fprintf(stderr, "%s: short read\n", path);
+        return 0;
+    }
+    fclose(file);
+
+    header = (const Elf32_Ehdr*)bench->image.file;
+    if(bench->image.fileSize < sizeof(Elf32_Ehdr) || memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+       header->e_ident[EI_CLASS] != ELFCLASS32 || header->e_machine != EM_ARM) {
+        fprintf(stderr, "%s: not an ARM ELF image\n", path);
+        return 0;
+    }
+
+    // Load every segment where it runs: .data straight into RAM, .bss zeroed
+    for(uint16_t i = 0; i < header->e_phnum; i++) {
+        const Elf32_Phdr *segment = (const Elf32_Phdr*)(bench->image.file + header->e_phoff + i * header->e_phentsize);
+        uint8_t *memory;
+
+        if(segment->p_type != PT_LOAD || segment->p_memsz == 0) {
+            continue;
+        }
+        memory = Cm0_Memory(bench->cpu, segment->p_vaddr, segment->p_memsz);
+        if(memory == NULL) {
+            fprintf(stderr, "%s: segment at 0x%08x does not fit the memory map\n", path, segment->p_vaddr);
+            return 0;
+        }
+        memcpy(memory, bench->image.file + segment->p_offset, segment->p_filesz);
+        memset(memory + segment->p_filesz, 0, segment->p_memsz - segment->p_filesz);
+    }
+
+    for(uint16_t i = 0; i < header->e_shnum; i++) {
+        const Elf32_Shdr *section = (const Elf32_Shdr*)(bench->image.file + header->e_shoff + i * header->e_shentsize);
+
+        if(section->sh_type == SHT_SYMTAB) {
+            const Elf32_Shdr *strings = (const Elf32_Shdr*)(bench->image.file + header->e_shoff + section->sh_link * header->e_shentsize);
+            bench->image.symbols = (const Elf32_Sym*)(bench->image.file + section->sh_offset);
+            bench->image.symbolCount = section->sh_size / sizeof(Elf32_Sym);
+            bench->image.names = (const char*)(bench->image.file + strings->sh_offset);
+        }
+    }
+    if(bench->image.symbols == NULL) {
+        fprintf(stderr, "%s: no symbol table, link without -s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+/* Address of a function or variable, 0 if the image does not have it */
+static uint32_t Bench_Symbol(bench_t *bench, const char *name, uint32_t *size)
+{
+    for(uint32_t i = 0; i < bench->image.symbolCount; i++) {
+        const Elf32_Sym *symbol = &bench->image.symbols[i];
+        uint8_t type = ELF32_ST_TYPE(symbol->st_info);
+
+        if((type == STT_FUNC || type == STT_OBJECT) && strcmp(bench->image.names + symbol->st_name, name) == 0) {
+            if(size != NULL) {
+                *size = symbol->st_size;
+            }
+            return symbol->st_value;
+        }
+    }
+    return 0;
+}
+
+static uint32_t Bench_Isr(bench_t *bench, uint32_t address)
+{
+    uint64_t cycles = 0;
+    uint32_t result = 0;
+
+    if(address != 0) {
+        result = Cm0_Call(bench->cpu, address, NULL, 0, &cycles);
+        bench->isrCycles += cycles;
+    }
+    return result;
+}
+
+/* HAL_TIM_PWM_Start_DMA: a buffered frame is out as soon as it starts, a
+ * streaming one is refilled from Bench_Drain */
+static uint32_t Bench_DmaStart(cm0_t *cpu, void *context)
+{
+    bench_t *bench = context;
+
+    (void)cpu;
+    if(!bench->streaming) {
+        Bench_Isr(bench, bench->pulseFinished);
+    }
+    return 0;   // HAL_OK
+}
+
+static uint32_t Bench_Stub(cm0_t *cpu, void *context)
+{
+    (void)cpu;
+    (void)context;
+    return 0;   // HAL_OK
+}
+
+/* Streaming builds keep the transport busy across several DMA interrupts and
+ * the latch, run them in the order the hardware raises them until the frame
+ * is done: half and full transfer in turn, then, once the latch has taken the
+ * DMA request away, only the timer update */
+static void Bench_Drain(bench_t *bench)
+{
+    uint8_t half = 0;
+
+    if(bench->isBusy == 0) {
+        return;
+    }
+    for(uint16_t round = 0; round < BENCH_DRAIN_ROUNDS && Cm0_Call(bench->cpu, bench->isBusy, NULL, 0, NULL); round++) {
+        uint64_t before = bench->isrCycles;
+
+        if(Cm0_Read32(bench->cpu, BENCH_TIM3 + BENCH_TIM_DIER) & BENCH_TIM_DIER_UIE) {
+            Bench_Isr(bench, bench->latchElapsed);
+            continue;
+        }
+        Bench_Isr(bench, half ? bench->pulseFinished : bench->pulseHalfFinished);
+        half ^= 1;
+        bench->refills.calls++;
+        bench->refills.total += bench->isrCycles - before;
+        if(bench->isrCycles - before > bench->refills.max) {
+            bench->refills.max = bench->isrCycles - before;
+        }
+    }
+}
+
+static void Bench_NextFrame(bench_t *bench)
+{
+    if(bench->uwTick != 0) {
+        Cm0_Write32(bench->cpu, bench->uwTick, Cm0_Read32(bench->cpu, bench->uwTick) + BENCH_FRAME_MS);
+    }
+    // The effects are called without RunEffect, hand them the one step it would
+    if(bench->effectSteps != 0) {
+        Cm0_Write16(bench->cpu, bench->effectSteps, 1);
+    }
+}
+
+static void Bench_Measure(bench_t *bench, bench_result_t *result, uint32_t address, const uint32_t *args, uint8_t argCount)
+{
+    uint64_t cycles = 0;
+
+    bench->isrCycles = 0;
+    Cm0_Call(bench->cpu, address, args, argCount, &cycles);
+    result->calls++;
+    result->total += cycles;
+    result->isr += bench->isrCycles;
+    if(cycles > result->max) {
+        result->max = cycles;
+    }
+}
+
+static void Bench_Print(bench_t *bench, const char *name, const bench_result_t *result, uint8_t perLed)
+{
+    uint64_t mean = result->total / result->calls;
+    char perLedText[16] = "-";
+    char isrText[16] = "-";
+
+    if(bench->cpu->fault != NULL) {
+        printf("%-36s fault: %s at 0x%08x\n", name, bench->cpu->fault, bench->cpu->r[15]);
+        bench->cpu->fault = NULL;
+        return;
+    }
+    if(perLed) {
+        snprintf(perLedText, sizeof(perLedText), "%.1f", (double)mean / bench->ledCount);
+    }
+    if(result->isr != 0) {
+        snprintf(isrText, sizeof(isrText), "%llu", (unsigned long long)(result->isr / result->calls));
+    }
+    printf("%-36s %5u %9llu %9llu %8s %8s %9.1f\n", name, result->calls, (unsigned long long)mean,
+           (unsigned long long)result->max, perLedText, isrText, result->max / 48.0);
+}
+
+static void Bench_Run(bench_t *bench, const char *path)
+{
+    uint32_t size = 0;
+    uint32_t address;
+    uint32_t setAll = Bench_Symbol(bench, "WS2812B_SetAllLED", NULL);
+    uint32_t colors = Bench_Symbol(bench, "currentColors", &size);
+    static const char *stubs[] = { "HAL_TIM_PWM_Stop_DMA", "HAL_DMA_Init", "HAL_DMA_Abort", "HAL_DMA_Abort_IT" };
+
+    // Buffered builds have the pixel array itself, streaming builds a pointer into pixelBuffers
+    if(size <= 4) {
+        Bench_Symbol(bench, "pixelBuffers", &size);
+        size /= 2;
+        bench->streaming = 1;
+    }
+    bench->ledCount = size / 4;
+    if(colors == 0 || bench->ledCount == 0) {
+        fprintf(stderr, "%s: no currentColors, not a WRadio image\n", path);
+        return;
+    }
+
+    bench->pulseFinished = Bench_Symbol(bench, "WS2812B_TIM_DMADelayPulseFinished", NULL);
+    bench->pulseHalfFinished = Bench_Symbol(bench, "WS2812B_TIM_DMADelayPulseHalfFinished", NULL);
+    bench->latchElapsed = Bench_Symbol(bench, "WS2812B_TIM_LatchElapsed", NULL);
+    bench->isBusy = Bench_Symbol(bench, "WS2812B_IsBusy", NULL);
+    bench->uwTick = Bench_Symbol(bench, "uwTick", NULL);
+    bench->effectSteps = Bench_Symbol(bench, "effectSteps", NULL);
+
+    if((address = Bench_Symbol(bench, "htim3", NULL)) != 0 && Cm0_Read32(bench->cpu, address) == 0) {
+        Cm0_Write32(bench->cpu, address, BENCH_TIM3);
+    }
+    if((address = Bench_Symbol(bench, "hdma_tim3_ch1_trig", NULL)) != 0 && Cm0_Read32(bench->cpu, address) == 0) {
+        Cm0_Write32(bench->cpu, address, BENCH_DMA_CHANNEL4);
+    }
+
+    if((address = Bench_Symbol(bench, "HAL_TIM_PWM_Start_DMA", NULL)) != 0) {
+        Cm0_Hook(bench->cpu, address, Bench_DmaStart, bench);
+    }
+    for(uint8_t i = 0; i < sizeof(stubs) / sizeof(stubs[0]); i++) {
+        if((address = Bench_Symbol(bench, stubs[i], NULL)) != 0) {
+            Cm0_Hook(bench->cpu, address, Bench_Stub, bench);
+        }
+    }
+
+    printf("%s: %u LEDs, Cortex-M0 at 48 MHz, %u flash wait state%s\n", path, bench->ledCount,
+           bench->cpu->flashWaitStates, bench->cpu->flashWaitStates == 1 ? "" : "s");
+    printf("%-36s %5s %9s %9s %8s %8s %9s\n", "cycles", "calls", "mean", "max", "per LED", "isr", "max us");
+
+    if((address = Bench_Symbol(bench, "WS2812B_Init", NULL)) != 0) {
+        Cm0_Call(bench->cpu, address, NULL, 0, NULL);
+        Bench_Drain(bench);
+    }
+
+    if((address = Bench_Symbol(bench, "WS2812B_Color", NULL)) != 0) {
+        bench_result_t result = { 0 };
+        for(uint32_t i = 0; i < BENCH_CALLS; i++) {
+            uint32_t args[3] = { i * 4, 255 - i * 4, i * 7 };
+            Bench_Measure(bench, &result, address, args, 3);
+        }
+        Bench_Print(bench, "WS2812B_Color", &result, 0);
+    }
+
+    // Byte-argument helpers, over every input: the computed colour wheel of
+    // older images and the lookup tables that replaced it
+    for(uint8_t helper = 0; helper < sizeof(byteHelpers) / sizeof(byteHelpers[0]); helper++) {
+        bench_result_t result = { 0 };
+
+        if((address = Bench_Symbol(bench, byteHelpers[helper], NULL)) == 0) {
+            continue;
+        }
+        for(uint32_t i = 0; i < 256; i++) {
+            Bench_Measure(bench, &result, address, &i, 1);
+        }
+        Bench_Print(bench, byteHelpers[helper], &result, 0);
+    }
+
+    // Every pixel changed: the full encode. Then nothing changed: what the
+    // dirty tracking leaves of it, where the build has any.
+    if((address = Bench_Symbol(bench, "WS2812B_PrepareBuffer", NULL)) != 0) {
+        bench_result_t changed = { 0 };
+        bench_result_t unchanged = { 0 };
+
+        for(uint32_t i = 0; i < BENCH_CALLS; i++) {
+            uint32_t args[3] = { i * 3, 128 + i, 255 - i * 2 };
+            if(setAll != 0) {
+                Cm0_Call(bench->cpu, setAll, args, 3, NULL);
+            } else {
+                for(uint16_t led = 0; led < bench->ledCount; led++) {
+                    Cm0_Write32(bench->cpu, colors + led * 4U, (args[0] << 16) | (args[1] << 8) | args[2]);
+                }
+            }
+            Bench_Measure(bench, &changed, address, NULL, 0);
+            Bench_Measure(bench, &unchanged, address, NULL, 0);
+        }
+        Bench_Print(bench, "WS2812B_PrepareBuffer", &changed, 1);
+        Bench_Print(bench, "WS2812B_PrepareBuffer (unchanged)", &unchanged, 1);
+    }
+
+    // Each effect renders and sends a frame per call, DMA done in between
+    for(uint8_t effect = 0; effect < sizeof(effects) / sizeof(effects[0]); effect++) {
+        bench_result_t result = { 0 };
+
+        if((address = Bench_Symbol(bench, effects[effect], NULL)) == 0) {
+            continue;
+        }
+        for(uint32_t i = 0; i < BENCH_CALLS; i++) {
+            Bench_NextFrame(bench);
+            Bench_Measure(bench, &result, address, NULL, 0);
+            Bench_Drain(bench);
+        }
+        Bench_Print(bench, effects[effect], &result, 1);
+    }
+
+    // One ring half refilled from the DMA interrupt, over every effect frame above
+    if(bench->refills.calls != 0) {
+        Bench_Print(bench, "refill (per DMA interrupt)", &bench->refills, 0);
+    }
+
+    // Settings record check: CRC unit in current builds, XOR in older ones
+    for(uint32_t i = 0; i < 8; i++) {
+        Cm0_Write32(bench->cpu, BENCH_SCRATCH + i * 4, 0x57524144U + i);
+    }
+    if((address = Bench_Symbol(bench, "Flash_Storage_Crc", NULL)) != 0) {
+        bench_result_t result = { 0 };
+        uint32_t args[2] = { BENCH_SCRATCH, 4 };
+        for(uint32_t i = 0; i < BENCH_CALLS; i++) {
+            Bench_Measure(bench, &result, address, args, 2);
+        }
+        Bench_Print(bench, "Flash_Storage_Crc (4 words)", &result, 0);
+    } else if((address = Bench_Symbol(bench, "Flash_Storage_CalculateChecksum", NULL)) != 0) {
+        bench_result_t result = { 0 };
+        uint32_t args[1] = { BENCH_SCRATCH };
+        for(uint32_t i = 0; i < BENCH_CALLS; i++) {
+            Bench_Measure(bench, &result, address, args, 1);
+        }
+        Bench_Print(bench, "Flash_Storage_CalculateChecksum", &result, 0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t waitStates = 1;
+    int first = 1;
+
+    if(argc > 2 && strcmp(argv[1], "-w") == 0) {
+        waitStates = atoi(argv[2]);
+        first = 3;
+    }
+    if(first >= argc) {
+        fprintf(stderr, "usage: %s [-w flash_wait_states] firmware.elf...\n", argv[0]);
+        return 2;
+    }
+
+    for(int i = first; i < argc; i++) {
+        bench_t bench = { 0 };
+
+        bench.cpu = Cm0_Create();
+        bench.cpu->flashWaitStates = waitStates;
+        if(Bench_Load(&bench, argv[i])) {
+            Bench_Run(&bench, argv[i]);
+        }
+        if(i + 1 < argc) {
+            printf("\n");
+        }
+        free(bench.image.file);
+        Cm0_Destroy(bench.cpu);
+    }
+    return 0;
+}
@@ -0,0 +1,638 @@
+/**
+******************************************************************************
+* @file           : cm0_emu.c
+* @brief          : ARMv6-M (Cortex-M0) instruction set emulator with cycle counts
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "cm0_emu.h"
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CRC_DR_ADDRESS      0x40023000U
+#define CRC_CR_ADDRESS      0x40023008U
+#define REG_SP              13
+#define REG_LR              14
+#define REG_PC              15
+
+cm0_t* Cm0_Create(void)
+{
+    cm0_t *cpu = calloc(1, sizeof(cm0_t));
+
+    cpu->flash = malloc(CM0_FLASH_SIZE);
+    memset(cpu->flash, 0xFF, CM0_FLASH_SIZE);
+    cpu->ram = calloc(1, CM0_RAM_SIZE);
+    cpu->apb = calloc(1, CM0_APB_SIZE);
+    cpu->gpio = calloc(1, CM0_GPIO_SIZE);
+    cpu->scs = calloc(1, CM0_SCS_SIZE);
+    cpu->crc = 0xFFFFFFFF;
+    cpu->flashWaitStates = 1;
+    cpu->r[REG_SP] = CM0_RAM_BASE + CM0_RAM_SIZE;
+    return cpu;
+}
+
+void Cm0_Destroy(cm0_t *cpu)
+{
+    free(cpu->flash);
+    free(cpu->ram);
+    free(cpu->apb);
+    free(cpu->gpio);
+    free(cpu->scs);
+    free(cpu);
+}
+
+/* Host pointer for a range of target memory, NULL if it is not all mapped */
+uint8_t* Cm0_Memory(cm0_t *cpu, uint32_t address, uint32_t size)
+{
+    static const struct { uint32_t base, size; size_t offset; } regions[] = {
+        { CM0_FLASH_BASE, CM0_FLASH_SIZE, offsetof(cm0_t, flash) },
+        { 0x00000000U,    CM0_FLASH_SIZE, offsetof(cm0_t, flash) },   // Boot alias of flash
+        { CM0_RAM_BASE,   CM0_RAM_SIZE,   offsetof(cm0_t, ram) },
+        { CM0_APB_BASE,   CM0_APB_SIZE,   offsetof(cm0_t, apb) },
+        { CM0_GPIO_BASE,  CM0_GPIO_SIZE,  offsetof(cm0_t, gpio) },
+        { CM0_SCS_BASE,   CM0_SCS_SIZE,   offsetof(cm0_t, scs) },
+    };
+
+    for(uint8_t i = 0; i < sizeof(regions) / sizeof(regions[0]); i++) {
+        if(address - regions[i].base < regions[i].size &&
+           size <= regions[i].size - (address - regions[i].base)) {
+            uint8_t *base = *(uint8_t**)((uint8_t*)cpu + regions[i].offset);
+            return base + (address - regions[i].base);
+        }
+    }
+    return NULL;
+}
+
+void Cm0_Hook(cm0_t *cpu, uint32_t address, cm0_hook_t hook, void *context)
+{
+    if(cpu->hookCount < CM0_MAX_HOOKS) {
+        cpu->hooks[cpu->hookCount].address = address & ~1U;
+        cpu->hooks[cpu->hookCount].hook = hook;
+        cpu->hooks[cpu->hookCount].context = context;
+        cpu->hookCount++;
+    }
+}
+
+static void Cm0_Fault(cm0_t *cpu, const char *reason)
+{
+    if(cpu->fault == NULL) {
+        cpu->fault = reason;
+    }
+}
+
+/* Flash reads stall for the wait states, the rest of the map is zero wait */
+static uint8_t* Cm0_Access(cm0_t *cpu, uint32_t address, uint8_t size)
+{
+    uint8_t *p;
+
+    if(address & (size - 1)) {
+        Cm0_Fault(cpu, "unaligned access");
+        return NULL;
+    }
+    p = Cm0_Memory(cpu, address, size);
+    if(p == NULL) {
+        Cm0_Fault(cpu, "access outside the memory map");
+    }
+    return p;
+}
+
+static uint32_t Cm0_Load(cm0_t *cpu, uint32_t address, uint8_t size)
+{
+    uint8_t *p = Cm0_Access(cpu, address, size);
+    uint32_t value = 0;
+
+    if(p == NULL) {
+        return 0;
+    }
+    if(address - CM0_FLASH_BASE < CM0_FLASH_SIZE || address < CM0_FLASH_SIZE) {
+        cpu->cycles += cpu->flashWaitStates;
+    }
+    if(address == CRC_DR_ADDRESS) {
+        return cpu->crc;
+    }
+    memcpy(&value, p, size);
+    return value;
+}
+
+/* The CRC unit: CRC-32 0x04C11DB7 over each word written to DR */
+static void Cm0_CrcWrite(cm0_t *cpu, uint32_t data)
+{
+    cpu->crc ^= data;
+    for(uint8_t bit = 0; bit < 32; bit++) {
+        cpu->crc = (cpu->crc & 0x80000000U) ? (cpu->crc << 1) ^ 0x04C11DB7U : cpu->crc << 1;
+    }
+}
+
+static void Cm0_Store(cm0_t *cpu, uint32_t address, uint32_t value, uint8_t size)
+{
+    uint8_t *p = Cm0_Access(cpu, address, size);
+
+    if(p == NULL) {
+        return;
+    }
+    if(address == CRC_DR_ADDRESS) {
+        Cm0_CrcWrite(cpu, value);
+        return;
+    }
+    if(address == CRC_CR_ADDRESS && (value & 1U)) {
+        cpu->crc = 0xFFFFFFFF;
+        value &= ~1U;
+    }
+    memcpy(p, &value, size);
+}
+
+uint32_t Cm0_Read32(cm0_t *cpu, uint32_t address)
+{
+    uint8_t *p = Cm0_Memory(cpu, address, 4);
+    uint32_t value = 0;
+
+    if(p != NULL) {
+        memcpy(&value, p, 4);
+    }
+    return value;
+}
+
+void Cm0_Write32(cm0_t *cpu, uint32_t address, uint32_t value)
+{
+    uint8_t *p = Cm0_Memory(cpu, address, 4);
+
+    if(p != NULL) {
+        memcpy(p, &value, 4);
+    }
+}
+
+void Cm0_Write16(cm0_t *cpu, uint32_t address, uint16_t value)
+{
+    uint8_t *p = Cm0_Memory(cpu, address, 2);
+
+    if(p != NULL) {
+        memcpy(p, &value, 2);
+    }
+}
+
+void Cm0_Write8(cm0_t *cpu, uint32_t address, uint8_t value)
+{
+    uint8_t *p = Cm0_Memory(cpu, address, 1);
+
+    if(p != NULL) {
+        *p = value;
+    }
+}
+
+static void Cm0_SetNZ(cm0_t *cpu, uint32_t result)
+{
+    cpu->n = result >> 31;
+    cpu->z = (result == 0);
+}
+
+/* AddWithCarry() of the ARM ARM, sets all four flags */
+static uint32_t Cm0_AddFlags(cm0_t *cpu, uint32_t a, uint32_t b, uint8_t carry)
+{
+    uint64_t unsignedSum = (uint64_t)a + b + carry;
+    int64_t signedSum = (int64_t)(int32_t)a + (int32_t)b + carry;
+    uint32_t result = (uint32_t)unsignedSum;
+
+    Cm0_SetNZ(cpu, result);
+    cpu->c = (unsignedSum >> 32) & 1U;
+    cpu->v = (signedSum != (int32_t)result);
+    return result;
+}
+
+static uint8_t Cm0_Condition(cm0_t *cpu, uint8_t cond)
+{
+    switch(cond >> 1) {
+        case 0: return cpu->z ^ (cond & 1);
+        case 1: return cpu->c ^ (cond & 1);
+        case 2: return cpu->n ^ (cond & 1);
+        case 3: return cpu->v ^ (cond & 1);
+        case 4: return (cpu->c && !cpu->z) ^ (cond & 1);
+        case 5: return (cpu->n == cpu->v) ^ (cond & 1);
+        case 6: return (!cpu->z && cpu->n == cpu->v) ^ (cond & 1);
+        default: return 1;
+    }
+}
+
+/* Jump to a new PC: 3 cycles for the pipeline refill plus the flash wait */
+static void Cm0_Branch(cm0_t *cpu, uint32_t target, uint8_t cycles)
+{
+    cpu->r[REG_PC] = target & ~1U;
+    cpu->cycles += cycles + cpu->flashWaitStates;
+}
+
+/* Shifts by a register amount, as LSLS/LSRS/ASRS/RORS Rdn, Rm */
+static uint32_t Cm0_Shift(cm0_t *cpu, uint8_t type, uint32_t value, uint8_t amount)
+{
+    if(amount == 0) {
+        return value;
+    }
+    switch(type) {
+        case 0:     // LSL
+            cpu->c = amount <= 32 ? (uint8_t)((uint64_t)value >> (32 - amount)) & 1U : 0;
+            return amount < 32 ? value << amount : 0;
+        case 1:     // LSR
+            cpu->c = amount <= 32 ? (value >> (amount - 1)) & 1U : 0;
+            return amount < 32 ? value >> amount : 0;
+        case 2:     // ASR
+            if(amount >= 32) {
+                cpu->c = value >> 31;
+                return (uint32_t)((int32_t)value >> 31);
+            }
+            cpu->c = ((int32_t)value >> (amount - 1)) & 1U;
+            return (uint32_t)((int32_t)value >> amount);
+        default:    // ROR
+            amount &= 31;
+            if(amount == 0) {
+                cpu->c = value >> 31;
+                return value;
+            }
+            value = (value >> amount) | (value << (32 - amount));
+            cpu->c = value >> 31;
+            return value;
+    }
+}
+
+static void Cm0_DataProcessing(cm0_t *cpu, uint16_t op)
+{
+    uint8_t rd = op & 7;
+    uint32_t a = cpu->r[rd];
+    uint32_t b = cpu->r[(op >> 3) & 7];
+    uint32_t result;
+
+    switch((op >> 6) & 0xF) {
+        case 0x0: result = a & b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x1: result = a ^ b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x2: result = Cm0_Shift(cpu, 0, a, b & 0xFF); Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x3: result = Cm0_Shift(cpu, 1, a, b & 0xFF); Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x4: result = Cm0_Shift(cpu, 2, a, b & 0xFF); Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x5: cpu->r[rd] = Cm0_AddFlags(cpu, a, b, cpu->c); break;
+        case 0x6: cpu->r[rd] = Cm0_AddFlags(cpu, a, ~b, cpu->c); break;
+        case 0x7: result = Cm0_Shift(cpu, 3, a, b & 0xFF); Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0x8: Cm0_SetNZ(cpu, a & b); break;
+        case 0x9: cpu->r[rd] = Cm0_AddFlags(cpu, ~b, 0, 1); break;      // RSBS Rd, Rn, #0
+        case 0xA: Cm0_AddFlags(cpu, a, ~b, 1); break;
+        case 0xB: Cm0_AddFlags(cpu, a, b, 0); break;
+        case 0xC: result = a | b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0xD: result = a * b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        case 0xE: result = a & ~b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+        default:  result = ~b; Cm0_SetNZ(cpu, result); cpu->r[rd] = result; break;
+    }
+    cpu->cycles += 1;
+}
+
+/* Register list transfers: PUSH/POP/STM/LDM, 1 + N cycles */
+static void Cm0_Transfer(cm0_t *cpu, uint32_t address, uint16_t list, uint8_t load)
+{
+    for(uint8_t i = 0; i < 16; i++) {
+        if(list & (1U << i)) {
+            if(load) {
+                cpu->r[i] = Cm0_Load(cpu, address, 4);
+            } else {
+                Cm0_Store(cpu, address, cpu->r[i], 4);
+            }
+            address += 4;
+            cpu->cycles += 1;
+        }
+    }
+    cpu->cycles += 1;
+}
+
+static uint8_t Cm0_Bits(uint16_t list)
+{
+    uint8_t count = 0;
+
+    for(; list; list &= list - 1) {
+        count++;
+    }
+    return count;
+}
+
+static void Cm0_Misc(cm0_t *cpu, uint16_t op)
+{
+    uint8_t rd = op & 7;
+    uint32_t rm = cpu->r[(op >> 3) & 7];
+
+    if((op & 0xFF00) == 0xB000) {           // ADD/SUB SP, SP, #imm7
+        cpu->r[REG_SP] += (op & 0x80) ? -(uint32_t)((op & 0x7F) << 2) : (uint32_t)((op & 0x7F) << 2);
+        cpu->cycles += 1;
+    } else if((op & 0xFF00) == 0xB200) {    // SXTH, SXTB, UXTH, UXTB
+        switch((op >> 6) & 3) {
+            case 0: cpu->r[rd] = (uint32_t)(int32_t)(int16_t)rm; break;
+            case 1: cpu->r[rd] = (uint32_t)(int32_t)(int8_t)rm; break;
+            case 2: cpu->r[rd] = rm & 0xFFFF; break;
+            default: cpu->r[rd] = rm & 0xFF; break;
+        }
+        cpu->cycles += 1;
+    } else if((op & 0xFE00) == 0xB400) {    // PUSH
+        uint16_t list = (op & 0xFF) | ((op & 0x100) ? (1U << REG_LR) : 0);
+        cpu->r[REG_SP] -= 4U * Cm0_Bits(list);
+        Cm0_Transfer(cpu, cpu->r[REG_SP], list, 0);
+    } else if((op & 0xFFEF) == 0xB662) {    // CPSIE/CPSID i
+        cpu->primask = (op >> 4) & 1;
+        cpu->cycles += 1;
+    } else if((op & 0xFF00) == 0xBA00) {    // REV, REV16, REVSH
+        switch((op >> 6) & 3) {
+            case 0: cpu->r[rd] = __builtin_bswap32(rm); break;
+            case 1: cpu->r[rd] = ((rm & 0x00FF00FFU) << 8) | ((rm >> 8) & 0x00FF00FFU); break;
+            case 3: cpu->r[rd] = (uint32_t)(int32_t)(int16_t)__builtin_bswap16((uint16_t)rm); break;
+            default: Cm0_Fault(cpu, "undefined instruction"); break;
+        }
+        cpu->cycles += 1;
+    } else if((op & 0xFE00) == 0xBC00) {    // POP
+        uint16_t list = (op & 0xFF) | ((op & 0x100) ? (1U << REG_PC) : 0);
+        uint32_t address = cpu->r[REG_SP];
+        cpu->r[REG_SP] += 4U * Cm0_Bits(list);
+        Cm0_Transfer(cpu, address, list, 1);
+        if(op & 0x100) {
+            Cm0_Branch(cpu, cpu->r[REG_PC], 2);
+        }
+    } else if((op & 0xFF00) == 0xBF00) {    // NOP, YIELD, WFE, WFI, SEV
+        cpu->cycles += 1;
+    } else {
+        Cm0_Fault(cpu, (op & 0xFF00) == 0xBE00 ? "breakpoint" : "undefined instruction");
+    }
+}
+
+/* The 32-bit encodings of ARMv6-M: BL, MSR, MRS and the barriers */
+static void Cm0_Wide(cm0_t *cpu, uint16_t op, uint16_t op2, uint32_t pc)
+{
+    if((op & 0xF800) == 0xF000 && (op2 & 0xD000) == 0xD000) {
+        uint32_t s = (op >> 10) & 1;
+        uint32_t i1 = !(((op2 >> 13) & 1) ^ s);
+        uint32_t i2 = !(((op2 >> 11) & 1) ^ s);
+        uint32_t offset = (s << 24) | (i1 << 23) | (i2 << 22) | ((op & 0x3FFU) << 12) | ((op2 & 0x7FFU) << 1);
+
+        if(s) {
+            offset |= 0xFE000000U;
+        }
+        cpu->r[REG_LR] = (pc + 4) | 1U;
+        Cm0_Branch(cpu, pc + 4 + offset, 4);
+    } else if((op & 0xFFF0) == 0xF380 && (op2 & 0xFF00) == 0x8800) {   // MSR
+        uint32_t value = cpu->r[op & 0xF];
+        switch(op2 & 0xFF) {
+            case 0x08: case 0x09: break;                                // MSP, PSP: not used
+            case 0x10: cpu->primask = value & 1; break;
+            default: cpu->n = value >> 31; cpu->z = (value >> 30) & 1; cpu->c = (value >> 29) & 1; cpu->v = (value >> 28) & 1; break;
+        }
+        cpu->cycles += 4;
+    } else if(op == 0xF3EF && (op2 & 0xF000) == 0x8000) {              // MRS
+        uint32_t value;
+        switch(op2 & 0xFF) {
+            case 0x08: case 0x09: value = cpu->r[REG_SP]; break;
+            case 0x10: value = cpu->primask; break;
+            default: value = ((uint32_t)cpu->n << 31) | ((uint32_t)cpu->z << 30) | ((uint32_t)cpu->c << 29) | ((uint32_t)cpu->v << 28); break;
+        }
+        cpu->r[(op2 >> 8) & 0xF] = value;
+        cpu->cycles += 4;
+    } else if(op == 0xF3BF && (op2 & 0xFF00) == 0x8F00) {              // DSB, DMB, ISB
+        cpu->cycles += 4;
+    } else {
+        Cm0_Fault(cpu, "undefined instruction");
+    }
+}
+
+static void Cm0_Step(cm0_t *cpu)
+{
+    uint32_t pc = cpu->r[REG_PC];
+    uint8_t *fetch = Cm0_Memory(cpu, pc, 2);
+    uint16_t op;
+    uint8_t rd;
+
+    if(fetch == NULL || (pc & 1U)) {
+        Cm0_Fault(cpu, "instruction fetch outside the memory map");
+        return;
+    }
+    memcpy(&op, fetch, 2);
+    cpu->r[REG_PC] = pc + 2;
+    cpu->instructions++;
+    rd = op & 7;
+
+    switch(op >> 11) {
+        case 0x00: case 0x01: case 0x02: {                  // LSLS, LSRS, ASRS #imm5
+            uint8_t amount = (op >> 6) & 0x1F;
+            uint32_t value = cpu->r[(op >> 3) & 7];
+            if(amount == 0 && (op >> 11) != 0) {
+                amount = 32;
+            }
+            value = Cm0_Shift(cpu, op >> 11, value, amount);
+            Cm0_SetNZ(cpu, value);
+            cpu->r[rd] = value;
+            cpu->cycles += 1;
+            break;
+        }
+        case 0x03: {                                        // ADDS/SUBS register or #imm3
+            uint32_t a = cpu->r[(op >> 3) & 7];
+            uint32_t b = (op & 0x400) ? (uint32_t)((op >> 6) & 7) : cpu->r[(op >> 6) & 7];
+            cpu->r[rd] = (op & 0x200) ? Cm0_AddFlags(cpu, a, ~b, 1) : Cm0_AddFlags(cpu, a, b, 0);
+            cpu->cycles += 1;
+            break;
+        }
+        case 0x04:                                          // MOVS #imm8
+            cpu->r[(op >> 8) & 7] = op & 0xFF;
+            Cm0_SetNZ(cpu, op & 0xFF);
+            cpu->cycles += 1;
+            break;
+        case 0x05:                                          // CMP #imm8
+            Cm0_AddFlags(cpu, cpu->r[(op >> 8) & 7], ~(uint32_t)(op & 0xFF), 1);
+            cpu->cycles += 1;
+            break;
+        case 0x06:                                          // ADDS #imm8
+            cpu->r[(op >> 8) & 7] = Cm0_AddFlags(cpu, cpu->r[(op >> 8) & 7], op & 0xFF, 0);
+            cpu->cycles += 1;
+            break;
+        case 0x07:                                          // SUBS #imm8
+            cpu->r[(op >> 8) & 7] = Cm0_AddFlags(cpu, cpu->r[(op >> 8) & 7], ~(uint32_t)(op & 0xFF), 1);
+            cpu->cycles += 1;
+            break;
+        case 0x08:
+            if((op & 0x0400) == 0) {
+                Cm0_DataProcessing(cpu, op);
+            } else {                                        // High register ADD, CMP, MOV, BX, BLX
+                uint8_t d = (op & 7) | ((op >> 4) & 8);
+                uint8_t m = (op >> 3) & 0xF;
+                uint32_t value = (m == REG_PC) ? pc + 4 : cpu->r[m];
+                switch((op >> 8) & 3) {
+                    case 0:
+                        value += (d == REG_PC) ? pc + 4 : cpu->r[d];
+                        if(d == REG_PC) {
+                            Cm0_Branch(cpu, value, 3);
+                        } else {
+                            cpu->r[d] = value;
+                            cpu->cycles += 1;
+                        }
+                        break;
+                    case 1:
+                        Cm0_AddFlags(cpu, cpu->r[d], ~value, 1);
+                        cpu->cycles += 1;
+                        break;
+                    case 2:
+                        if(d == REG_PC) {
+                            Cm0_Branch(cpu, value, 3);
+                        } else {
+                            cpu->r[d] = value;
+                            cpu->cycles += 1;
+                        }
+                        break;
+                    default:
+                        if(op & 0x80) {
+                            cpu->r[REG_LR] = (pc + 2) | 1U;
+                        }
+                        Cm0_Branch(cpu, value, 3);
+                        break;
+                }
+            }
+            break;
+        case 0x09:                                          // LDR Rt, [PC, #imm8]
+            cpu->r[(op >> 8) & 7] = Cm0_Load(cpu, ((pc + 4) & ~3U) + ((op & 0xFF) << 2), 4);
+            cpu->cycles += 2;
+            break;
+        case 0x0A: case 0x0B: {                             // Register offset loads and stores
+            uint32_t address = cpu->r[(op >> 3) & 7] + cpu->r[(op >> 6) & 7];
+            switch((op >> 9) & 7) {
+                case 0: Cm0_Store(cpu, address, cpu->r[rd], 4); break;
+                case 1: Cm0_Store(cpu, address, cpu->r[rd], 2); break;
+                case 2: Cm0_Store(cpu, address, cpu->r[rd], 1); break;
+                case 3: cpu->r[rd] = (uint32_t)(int32_t)(int8_t)Cm0_Load(cpu, address, 1); break;
+                case 4: cpu->r[rd] = Cm0_Load(cpu, address, 4); break;
+                case 5: cpu->r[rd] = Cm0_Load(cpu, address, 2); break;
+                case 6: cpu->r[rd] = Cm0_Load(cpu, address, 1); break;
+                default: cpu->r[rd] = (uint32_t)(int32_t)(int16_t)Cm0_Load(cpu, address, 2); break;
+            }
+            cpu->cycles += 2;
+            break;
+        }
+        case 0x0C: case 0x0D: case 0x0E: case 0x0F:
+        case 0x10: case 0x11: {                             // Immediate offset loads and stores
+            uint8_t size = (op >> 11) >= 0x10 ? 2 : ((op >> 11) >= 0x0E ? 1 : 4);
+            uint32_t address = cpu->r[(op >> 3) & 7] + ((op >> 6) & 0x1F) * size;
+            if(op & 0x0800) {
+                cpu->r[rd] = Cm0_Load(cpu, address, size);
+            } else {
+                Cm0_Store(cpu, address, cpu->r[rd], size);
+            }
+            cpu->cycles += 2;
+            break;
+        }
+        case 0x12: case 0x13: {                             // LDR/STR Rt, [SP, #imm8]
+            uint32_t address = cpu->r[REG_SP] + ((op & 0xFF) << 2);
+            if(op & 0x0800) {
+                cpu->r[(op >> 8) & 7] = Cm0_Load(cpu, address, 4);
+            } else {
+                Cm0_Store(cpu, address, cpu->r[(op >> 8) & 7], 4);
+            }
+            cpu->cycles += 2;
+            break;
+        }
+        case 0x14:                                          // ADR
+            cpu->r[(op >> 8) & 7] = ((pc + 4) & ~3U) + ((op & 0xFF) << 2);
+            cpu->cycles += 1;
+            break;
+        case 0x15:                                          // ADD Rd, SP, #imm8
+            cpu->r[(op >> 8) & 7] = cpu->r[REG_SP] + ((op & 0xFF) << 2);
+            cpu->cycles += 1;
+            break;
+        case 0x16: case 0x17:
+            Cm0_Misc(cpu, op);
+            break;
+        case 0x18: case 0x19: {                             // STMIA/LDMIA Rn!, {list}
+            uint8_t rn = (op >> 8) & 7;
+            uint16_t list = op & 0xFF;
+            uint32_t address = cpu->r[rn];
+            uint8_t load = (op >> 11) & 1;
+            Cm0_Transfer(cpu, address, list, load);
+            if(!load || !(list & (1U << rn))) {
+                cpu->r[rn] = address + 4U * Cm0_Bits(list);
+            }
+            break;
+        }
+        case 0x1A: case 0x1B: {                             // B<cond>, UDF, SVC
+            uint8_t cond = (op >> 8) & 0xF;
+            if(cond >= 0xE) {
+                Cm0_Fault(cpu, cond == 0xF ? "supervisor call" : "undefined instruction");
+            } else if(Cm0_Condition(cpu, cond)) {
+                Cm0_Branch(cpu, pc + 4 + (uint32_t)((int32_t)(int8_t)(op & 0xFF) * 2), 3);
+            } else {
+                cpu->cycles += 1;
+            }
+            break;
+        }
+        case 0x1C:                                          // B
+            Cm0_Branch(cpu, pc + 4 + (uint32_t)((int32_t)((uint32_t)op << 21) >> 20), 3);
+            break;
+        default: {
+            uint8_t *second = Cm0_Memory(cpu, pc + 2, 2);
+            uint16_t op2 = 0;
+            if((op >> 11) == 0x1D || second == NULL) {
+                Cm0_Fault(cpu, "undefined instruction");
+                break;
+            }
+            memcpy(&op2, second, 2);
+            cpu->r[REG_PC] = pc + 4;
+            Cm0_Wide(cpu, op, op2, pc);
+            break;
+        }
+    }
+}
+
+/* Calls a function of the image with up to four arguments and runs it to
+ * its return. Cycles spent in the call (hooks excluded) go to *cycles. The
+ * register state is kept, so hooks may call back into the image. */
+uint32_t Cm0_Call(cm0_t *cpu, uint32_t address, const uint32_t *args, uint8_t argCount, uint64_t *cycles)
+{
+    uint32_t saved[16];
+    uint8_t savedFlags[4] = { cpu->n, cpu->z, cpu->c, cpu->v };
+    uint64_t start = cpu->cycles;
+    uint32_t result;
+
+    memcpy(saved, cpu->r, sizeof(saved));
+    for(uint8_t i = 0; i < argCount && i < 4; i++) {
+        cpu->r[i] = args[i];
+    }
+    cpu->r[REG_SP] &= ~7U;
+    cpu->r[REG_LR] = CM0_RETURN | 1U;
+    cpu->r[REG_PC] = address & ~1U;
+
+    while(cpu->r[REG_PC] != CM0_RETURN && cpu->fault == NULL) {
+        uint8_t hooked = 0;
+
+        for(uint8_t i = 0; i < cpu->hookCount; i++) {
+            if(cpu->hooks[i].address == cpu->r[REG_PC]) {
+                uint32_t lr = cpu->r[REG_LR];
+                uint64_t before = cpu->cycles;
+                cpu->r[0] = cpu->hooks[i].hook(cpu, cpu->hooks[i].context);
+                cpu->cycles = before;
+                Cm0_Branch(cpu, lr, 3);     // As the BX LR of the replaced function
+                hooked = 1;
+                break;
+            }
+        }
+        if(!hooked) {
+            Cm0_Step(cpu);
+        }
+    }
+
+    result = cpu->r[0];
+    if(cycles != NULL) {
+        *cycles = cpu->cycles - start;
+    }
+    memcpy(cpu->r, saved, sizeof(saved));
+    cpu->n = savedFlags[0];
+    cpu->z = savedFlags[1];
+    cpu->c = savedFlags[2];
+    cpu->v = savedFlags[3];
+    return result;
+}
@@ -0,0 +1,163 @@
+/**
+******************************************************************************
+* @file           : fixed_check.c
+* @brief          : checks the fixed-point helpers against exact integer math
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "fixed_math.h"
+#include <stdio.h>
+
+/* Every helper is run over its full 8-bit input range and compared with the
+ * exact result worked out with a division, which the target does not have.
+ * MulQ16 takes 32-bit inputs, so it gets a grid of signed values instead. */
+static uint8_t failed;
+
+static void Fixed_Check_Report(const char *name, uint32_t errors)
+{
+    if (errors) {
+        printf("%-12s %lu mismatches\n", name, (unsigned long)errors);
+        failed = 1;
+        return;
+    }
+    printf("%-12s ok\n", name);
+}
+
+/* Exact at scale 0 and 255, otherwise the floor of x * scale / 255 or one above */
+static void Fixed_Check_Scale8(void)
+{
+    uint32_t errors = 0;
+
+    for (uint16_t x = 0; x < 256; x++) {
+        for (uint16_t scale = 0; scale < 256; scale++) {
+            uint8_t result = Fixed_Math_Scale8(x, scale);
+            uint8_t exact = x * scale / 255;
+            if ((scale == 0 || scale == 255) ? result != exact : (result != exact && result != exact + 1)) {
+                errors++;
+            }
+        }
+    }
+    Fixed_Check_Report("scale8", errors);
+}
+
+/* Exact: the floor of x * percent / 100, saturating at 255 */
+static void Fixed_Check_Percent8(void)
+{
+    uint32_t errors = 0;
+
+    for (uint16_t x = 0; x < 256; x++) {
+        for (uint16_t percent = 0; percent < 256; percent++) {
+            uint32_t exact = x * percent / 100;
+            if (Fixed_Math_Percent8(x, percent) != (exact > 255 ? 255 : exact)) {
+                errors++;
+            }
+        }
+    }
+    Fixed_Check_Report("percent8", errors);
+}
+
+/* Lands on from and to at frac 0 and 255, stays within one step of the exact
+ * blend and never moves away from to as frac grows */
+static void Fixed_Check_Lerp8(void)
+{
+    uint32_t errors = 0;
+
+    for (uint16_t from = 0; from < 256; from++) {
+        for (uint16_t to = 0; to < 256; to++) {
+            uint8_t previous = from;
+            for (uint16_t frac = 0; frac < 256; frac++) {
+                uint8_t result = Fixed_Math_Lerp8(from, to, frac);
+                int32_t exact2 = 2 * from * 255 + 2 * ((int32_t)to - from) * frac;    // 510 x the blend
+                int32_t error2 = 2 * 255 * result - exact2;
+                uint8_t backwards = (to >= from) ? (result < previous) : (result > previous);
+                if ((frac == 0 && result != from) || (frac == 255 && result != to) ||
+                    error2 <= -510 || error2 >= 510 || backwards) {
+                    errors++;
+                }
+                previous = result;
+            }
+        }
+    }
+    Fixed_Check_Report("lerp8", errors);
+}
+
+/* Channel by channel the same as Scale8 and Lerp8, with no carry between them */
+static void Fixed_Check_Color(void)
+{
+    static const uint32_t colors[] = { 0x000000, 0xFFFFFF, 0xFF0000, 0x00FF00, 0x0000FF, 0x123456, 0xFEDCBA, 0x80FF01 };
+    const uint8_t count = sizeof(colors) / sizeof(colors[0]);
+    uint32_t errors = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint16_t frac = 0; frac < 256; frac++) {
+            uint32_t a = colors[i];
+            uint32_t scaled = ((uint32_t)Fixed_Math_Scale8(a >> 16, frac) << 16) |
+                              ((uint32_t)Fixed_Math_Scale8((a >> 8) & 0xFF, frac) << 8) |
+                              Fixed_Math_Scale8(a & 0xFF, frac);
+            if (Fixed_Math_ScaleColor(a, frac) != scaled) {
+                errors++;
+            }
+            for (uint8_t j = 0; j < count; j++) {
+                uint32_t b = colors[j];
+                uint32_t blended = ((uint32_t)Fixed_Math_Lerp8(a >> 16, b >> 16, frac) << 16) |
+                                   ((uint32_t)Fixed_Math_Lerp8((a >> 8) & 0xFF, (b >> 8) & 0xFF, frac) << 8) |
+                                   Fixed_Math_Lerp8(a & 0xFF, b & 0xFF, frac);
+                if (Fixed_Math_LerpColor(a, b, frac) != blended) {
+                    errors++;
+                }
+            }
+        }
+    }
+    Fixed_Check_Report("color", errors);
+}
+
+/* The floor of a * b / 65536 for signed 16.16 inputs, ONE is the identity */
+static void Fixed_Check_MulQ16(void)
+{
+    static const q16_t values[] = {
+        0, 1, -1, FIXED_Q16_ONE, -FIXED_Q16_ONE, FIXED_Q16(0.5), FIXED_Q16(-0.25), FIXED_Q16(3.75),
+        FIXED_Q16(-100.125), 0x7FFF, 0x12345, -0x12345, 0x7FFFFFFF, INT32_MIN + 1,
+    };
+    const uint8_t count = sizeof(values) / sizeof(values[0]);
+    uint32_t errors = 0;
+
+    if (FIXED_Q16(1.0) != FIXED_Q16_ONE || FIXED_Q16(-2.5) != -0x28000) {
+        errors++;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        if (Fixed_Math_MulQ16(values[i], FIXED_Q16_ONE) != values[i]) {
+            errors++;
+        }
+        for (uint8_t j = 0; j < count; j++) {
+            int64_t product = (int64_t)values[i] * values[j];
+            int64_t exact = (product >= 0) ? product / 65536 : -((-product + 65535) / 65536);
+            if ((int64_t)Fixed_Math_MulQ16(values[i], values[j]) != (int64_t)(int32_t)exact) {
+                errors++;
+            }
+        }
+    }
+    Fixed_Check_Report("mulq16", errors);
+}
+
+int main(void)
+{
+    Fixed_Check_Scale8();
+    Fixed_Check_Percent8();
+    Fixed_Check_Lerp8();
+    Fixed_Check_Color();
+    Fixed_Check_MulQ16();
+    return failed;
+}
@@ -0,0 +1,207 @@
+/**
+******************************************************************************
+* @file           : golden.c
+* @brief          : golden-frame regression of every effect on the host build
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "host.h"
+#include "ws2812b.h"
+#include "frame_scheduler.h"
+#include "fixed_math.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Each effect runs in its own process, booted straight into its mode from a
+ * settings record, and GOLDEN_FRAMES frames of currentColors are written as
+ * a PPM strip: one row per frame, the W, R and background ranges side by
+ * side with a dark column between them. Brightness is applied so effects
+ * that only change globalBrightness show up too. */
+#define GOLDEN_FRAMES           64
+#define GOLDEN_STATIC_STEP_US   100000  // Row spacing for modes without a frame clock
+#define GOLDEN_POLL_US          1000    // Shorter than any effect period
+#define GOLDEN_BRIGHTNESS_LEVEL 2
+#define GOLDEN_WIDTH            (LED_COUNT + 2)
+#define GOLDEN_SEPARATOR        0x202020
+
+#if WS2812B_STREAMING
+extern uint32_t *currentColors;
+#else
+extern uint32_t currentColors[LED_COUNT];
+#endif
+
+static const char *const modeNames[MODE_COUNT] = {
+    [MODE_STATIC_LOGO] = "static_logo",
+    [MODE_BREATHE]     = "breathe",
+    [MODE_SPARKLE]     = "sparkle",
+    [MODE_WAVE]        = "wave",
+    [MODE_PULSE]       = "pulse",
+    [MODE_RAINBOW]     = "rainbow",
+    [MODE_COMET]       = "comet",
+    [MODE_FILL]        = "fill",
+    [MODE_SCANNER]     = "scanner",
+    [MODE_COLOR_SHIFT] = "color_shift",
+    [MODE_STROBE]      = "strobe",
+};
+
+static uint8_t strip[GOLDEN_FRAMES][GOLDEN_WIDTH][3];
+
+static void Golden_SetPixel(uint16_t row, uint16_t column, uint32_t color)
+{
+    strip[row][column][0] = (uint8_t)(color >> 16);
+    strip[row][column][1] = (uint8_t)(color >> 8);
+    strip[row][column][2] = (uint8_t)color;
+}
+
+static void Golden_Sample(uint16_t row)
+{
+    uint16_t column = 0;
+
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        if (i == R_START || i == R_END + 1) {
+            Golden_SetPixel(row, column++, GOLDEN_SEPARATOR);
+        }
+        Golden_SetPixel(row, column++, Fixed_Math_ScaleColor(currentColors[i], globalBrightness));
+    }
+}
+
+/* Child process: boot into mode and record one row per rendered frame */
+static int Golden_Record(effect_mode_t mode, const char *path)
+{
+    Host_StoreSettings(mode, GOLDEN_BRIGHTNESS_LEVEL);
+    Host_Boot();
+    Host_Run(GOLDEN_POLL_US);
+
+    const frame_scheduler_stats_t *stats = Frame_Scheduler_GetStats();
+    uint32_t recorded = stats->frames;
+
+    for (uint16_t row = 0; row < GOLDEN_FRAMES; row++) {
+        if (stats->periodUs == 0) {
+            Host_Run(Host_Micros() + GOLDEN_STATIC_STEP_US);
+        } else {
+            while (stats->frames == recorded) {
+                Host_Run(Host_Micros() + GOLDEN_POLL_US);
+            }
+            recorded = stats->frames;
+        }
+        Golden_Sample(row);
+    }
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        perror(path);
+        return 1;
+    }
+    fprintf(file, "P6\n# %s: %u frames, W | R | background\n%u %u\n255\n",
+            modeNames[mode], GOLDEN_FRAMES, GOLDEN_WIDTH, GOLDEN_FRAMES);
+    fwrite(strip, sizeof(strip), 1, file);
+    fclose(file);
+    return 0;
+}
+
+static uint8_t* Golden_Load(const char *path, long *size)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) return NULL;
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    rewind(file);
+
+    uint8_t *data = malloc(*size);
+    if (fread(data, 1, *size, file) != (size_t)*size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+/* 1 if the new strip matches the golden one, else reports the first change */
+static uint8_t Golden_Compare(const char *goldenPath, const char *outputPath)
+{
+    long goldenSize, outputSize;
+    uint8_t *golden = Golden_Load(goldenPath, &goldenSize);
+    uint8_t *output = Golden_Load(outputPath, &outputSize);
+    uint8_t match = 0;
+
+    if (golden == NULL) {
+        printf("  no golden file %s\n", goldenPath);
+    } else if (output == NULL) {
+        printf("  no output\n");
+    } else if (goldenSize != outputSize) {
+        printf("  size %ld, golden %ld\n", outputSize, goldenSize);
+    } else {
+        long pixels = sizeof(strip);
+        long offset = outputSize - pixels;
+        long diff = 0;
+
+        while (diff < pixels && golden[offset + diff] == output[offset + diff]) {
+            diff++;
+        }
+        match = (diff == pixels) && memcmp(golden, output, offset) == 0;
+        if (!match && diff < pixels) {
+            long column = (diff / 3) % GOLDEN_WIDTH;
+            long led = column - (column > R_START) - (column > R_END + 2);
+            printf("  first change at frame %ld, LED %ld\n", diff / 3 / GOLDEN_WIDTH, led);
+        }
+    }
+
+    free(golden);
+    free(output);
+    return match;
+}
+
+int main(int argc, char **argv)
+{
+    uint8_t update = (argc > 1 && strcmp(argv[1], "--update") == 0);
+    const char *goldenDir = "golden";
+    const char *outputDir = update ? goldenDir : "build/golden";
+    uint8_t failed = 0;
+    char goldenPath[256], outputPath[256];
+
+    if (!update && system("mkdir -p build/golden") != 0) return 1;
+
+    for (uint8_t mode = MODE_STATIC_LOGO; mode < MODE_COUNT; mode++) {
+        snprintf(goldenPath, sizeof(goldenPath), "%s/%02u_%s.ppm", goldenDir, mode, modeNames[mode]);
+        snprintf(outputPath, sizeof(outputPath), "%s/%02u_%s.ppm", outputDir, mode, modeNames[mode]);
+
+        // Firmware state is static, a fresh process per mode starts from reset
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) {
+            exit(Golden_Record(mode, outputPath));
+        }
+
+        int status;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("%-12s FAILED to run\n", modeNames[mode]);
+            failed = 1;
+        } else if (update) {
+            printf("%-12s written to %s\n", modeNames[mode], outputPath);
+        } else if (Golden_Compare(goldenPath, outputPath)) {
+            printf("%-12s ok\n", modeNames[mode]);
+        } else {
+            printf("%-12s CHANGED, see %s\n", modeNames[mode], outputPath);
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
@@ -0,0 +1,649 @@
+/**
+******************************************************************************
+* @file           : hal_shim.c
+* @brief          : HAL stubs, virtual clock, TIM3/DMA capture, PA0 and flash for the host build
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "host.h"
+#include "flash_storage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+#define HOST_STACK_SIZE     (256 * 1024)
+
+extern DMA_HandleTypeDef hdma_tim3_ch1_trig;
+
+/* Registers */
+uint32_t hostPrimask = 0;
+TIM_TypeDef hostTim3, hostTim16;
+DMA_Channel_TypeDef hostDma1Channel4;
+FLASH_TypeDef hostFlash;
+CRC_TypeDef hostCrc;
+GPIO_TypeDef hostGpioA;
+SysTick_Type hostSysTick = { .LOAD = 1000 * HOST_HCLK_PER_US - 1 };
+
+__IO uint32_t uwTick = 0;
+uint32_t uwTickFreq = 1;
+
+/* Virtual clock */
+static uint64_t nowUs = 0;
+static uint32_t limitUs = 0;            // Host_Run hands control back once idle past this
+static uint16_t sysTickUs = 0;
+static uint8_t sysTickPending = 0;      // Masked SysTick interrupts pend once, further ones are lost
+static uint8_t tickSuspended = 0;
+static uint8_t stopMode = 0;            // Clocks off, only the EXTI line can wake the core
+static uint8_t inInterrupt = 0;
+static uint8_t flashBusy = 0;           // Vector table is in flash, interrupts wait
+
+/* TIM3 + DMA1_Channel4: the shadow registers the preloads go to at each update */
+static uint32_t tim3Count = 0;
+static uint32_t tim3ActiveArr = 59;
+static uint32_t tim3ActiveCcr = 0;
+static const uint8_t *dmaSource = NULL;
+static uint16_t dmaLength = 0;
+static uint16_t dmaIndex = 0;
+static uint8_t dmaActive = 0;
+static uint8_t dmaCircular = 0;
+static uint8_t dmaHalfPending = 0;
+static uint8_t dmaCompletePending = 0;
+
+static uint8_t extiPending = 0;
+
+/* Data line capture */
+static host_pulse_t capture[HOST_CAPTURE_MAX];
+static uint32_t captureCount = 0;
+static uint64_t lineFallClock = 0;      // HCLK count at the last falling edge of the data line
+static uint8_t capturing = 0;
+static host_pulse_t lastFrame[HOST_CAPTURE_MAX];
+static uint32_t lastFrameCount = 0;
+static uint32_t frameCount = 0;
+static host_frame_hook_t frameHook = NULL;
+static host_submit_hook_t submitHook = NULL;
+
+static host_flash_stats_t flashStats;
+
+static ucontext_t hostContext;
+static ucontext_t firmwareContext;
+static uint8_t booted = 0;
+
+/* Flash ---------------------------------------------------------------------*/
+
+/* Map the flash at its real address, the storage code works on uint32_t addresses */
+__attribute__((constructor))
+static void Host_MapFlash(void)
+{
+    void *flash = mmap((void *)(uintptr_t)HOST_FLASH_BASE, HOST_FLASH_SIZE, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+    if (flash != (void *)(uintptr_t)HOST_FLASH_BASE) {
+        perror("host: cannot map flash at 0x08000000");
+        exit(1);
+    }
+    memset(flash, 0xFF, HOST_FLASH_SIZE);
+}
+
+uint8_t* Host_Flash(uint32_t address)
+{
+    return (uint8_t *)(uintptr_t)address;
+}
+
+void Host_FlashErase(void)
+{
+    memset(Host_Flash(HOST_FLASH_BASE), 0xFF, HOST_FLASH_SIZE);
+}
+
+const host_flash_stats_t* Host_GetFlashStats(void)
+{
+    return &flashStats;
+}
+
+/* Write a settings record the way the firmware does, so it boots with them */
+void Host_StoreSettings(uint8_t mode, uint8_t brightnessLevel)
+{
+    uint32_t record[5];
+    flash_record_header_t header = {
+        .magic = FLASH_STORAGE_RECORD_MAGIC,
+        .version = FLASH_SETTINGS_VERSION,
+        .words = sizeof(record) / sizeof(record[0]),
+        .sequence = 1,
+    };
+    flash_settings_t settings = {
+        .mode = mode,
+        .brightnessLevel = brightnessLevel,
+    };
+
+    memcpy(&record[0], &header, sizeof(header));
+    memcpy(&record[3], &settings, sizeof(settings));
+    record[4] = Flash_Storage_Crc(record, 4);
+    memcpy(Host_Flash(FLASH_STORAGE_PAGE_ADDR), record, sizeof(record));
+}
+
+/* CRC unit in software: CRC-32 0x04C11DB7, init all ones, no reflection */
+uint32_t Flash_Storage_Crc(const uint32_t* data, uint32_t words)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    while (words--) {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 32; bit++) {
+            crc = (crc & 0x80000000) ? (crc << 1) ^ 0x04C11DB7 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+/* Capture -------------------------------------------------------------------*/
+
+static void Host_EndFrame(void)
+{
+    if (!capturing) return;
+
+    capturing = 0;
+    memcpy(lastFrame, capture, captureCount * sizeof(capture[0]));
+    lastFrameCount = captureCount;
+    frameCount++;
+
+    if (frameHook != NULL) {
+        frameHook(lastFrame, lastFrameCount);
+    }
+}
+
+static void Host_RecordPulse(uint32_t high, uint32_t period)
+{
+    if (!capturing) return;
+
+    if (high > period) high = period;
+    if (high == 0 && captureCount > 0 && capture[captureCount - 1].high == 0) {
+        capture[captureCount - 1].period += period;
+    } else if (captureCount < HOST_CAPTURE_MAX) {
+        capture[captureCount].high = (uint16_t)high;
+        capture[captureCount].period = period;
+        captureCount++;
+    }
+
+    // No more data coming and the line has been low for a reset: frame latched
+    uint8_t feeding = dmaActive && (TIM3->DIER & TIM_DIER_CC1DE);
+    if (!feeding && high == 0 && capture[captureCount - 1].period >= HOST_RESET_CLOCKS) {
+        Host_EndFrame();
+    }
+}
+
+uint32_t Host_GetFrameCount(void)
+{
+    return frameCount;
+}
+
+const host_pulse_t* Host_GetFrame(uint32_t *count)
+{
+    *count = lastFrameCount;
+    return lastFrame;
+}
+
+void Host_SetFrameHook(host_frame_hook_t hook)
+{
+    frameHook = hook;
+}
+
+void Host_SetSubmitHook(host_submit_hook_t hook)
+{
+    submitHook = hook;
+}
+
+/* Hardware ------------------------------------------------------------------*/
+
+/* TIM16 counts microseconds (prescaler 47) */
+static void Host_TimerTick(TIM_TypeDef *tim)
+{
+    if (!(tim->CR1 & 1)) return;
+
+    tim->CNT = (tim->CNT >= tim->ARR) ? 0 : tim->CNT + 1;
+    if (tim->CNT == 0) tim->SR |= TIM_SR_UIF;
+    if (tim->CNT == tim->CCR1) tim->SR |= TIM_SR_CC1IF;
+}
+
+/* Event generation takes effect straight away on the real timer */
+static void Host_ApplyEvents(TIM_TypeDef *tim)
+{
+    if (tim->EGR & TIM_EGR_CC1G) tim->SR |= TIM_SR_CC1IF;
+    if (tim->EGR & TIM_EGR_UG) {
+        tim->CNT = 0;
+        if (tim == TIM3) {
+            tim3Count = 0;
+            tim3ActiveArr = TIM3->ARR;
+            tim3ActiveCcr = TIM3->CCR1;
+        }
+    }
+    tim->EGR = 0;
+}
+
+/* The CC1 event requests the next byte, it lands in the CCR1 preload */
+static void Host_DmaRequest(void)
+{
+    if (!dmaActive || !(TIM3->DIER & TIM_DIER_CC1DE)) return;
+
+    TIM3->CCR1 = dmaSource[dmaIndex++];
+    if (dmaIndex == dmaLength / 2) dmaHalfPending = 1;
+    if (dmaIndex == dmaLength) {
+        dmaCompletePending = 1;
+        dmaIndex = 0;
+        dmaActive = dmaCircular;
+    }
+    DMA1_Channel4->CNDTR = dmaLength - dmaIndex;
+}
+
+static void Host_Tim3Tick(void)
+{
+    if (!(TIM3->CR1 & 1)) return;
+
+    uint64_t clockBase = (nowUs - 1) * HOST_HCLK_PER_US;
+
+    for (uint8_t clock = 0; clock < HOST_HCLK_PER_US; clock++) {
+        if (tim3Count == tim3ActiveCcr) Host_DmaRequest();
+
+        if (++tim3Count > tim3ActiveArr) {
+            uint32_t high = tim3ActiveCcr, period = tim3ActiveArr + 1;
+
+            if (high > 0) {
+                lineFallClock = clockBase + clock + 1 - period + ((high < period) ? high : period);
+            }
+
+            tim3Count = 0;
+            tim3ActiveArr = TIM3->ARR;
+            tim3ActiveCcr = TIM3->CCR1;
+            TIM3->SR |= TIM_SR_UIF;
+            Host_RecordPulse(high, period);
+        }
+    }
+}
+
+static void Host_Tick(void)
+{
+    nowUs++;
+    if (stopMode) return;
+
+    Host_ApplyEvents(TIM16);
+    Host_TimerTick(TIM16);
+    Host_Tim3Tick();
+
+    if (!tickSuspended && ++sysTickUs == 1000) {
+        sysTickUs = 0;
+        if (hostPrimask || flashBusy) {
+            sysTickPending = 1;
+        } else {
+            uwTick += uwTickFreq;
+        }
+    }
+    SysTick->VAL = SysTick->LOAD - sysTickUs * HOST_HCLK_PER_US;
+}
+
+static uint8_t Host_TimerPending(TIM_TypeDef *tim)
+{
+    return (tim->SR & tim->DIER & (TIM_SR_UIF | TIM_SR_CC1IF)) != 0;
+}
+
+static uint8_t Host_InterruptPending(void)
+{
+    Host_ApplyEvents(TIM3);
+    Host_ApplyEvents(TIM16);
+
+    return extiPending || dmaHalfPending || dmaCompletePending || Host_TimerPending(TIM3)
+           || Host_TimerPending(TIM16);
+}
+
+/* What HAL_TIM_IRQHandler does for the flags the firmware uses */
+static void Host_TimerInterrupt(TIM_HandleTypeDef *htim)
+{
+    TIM_TypeDef *tim = htim->Instance;
+
+    if (tim->SR & tim->DIER & TIM_SR_CC1IF) {
+        tim->SR &= ~TIM_SR_CC1IF;
+        HAL_TIM_OC_DelayElapsedCallback(htim);
+        HAL_TIM_PWM_PulseFinishedCallback(htim);
+    }
+    if (tim->SR & tim->DIER & TIM_SR_UIF) {
+        tim->SR &= ~TIM_SR_UIF;
+        HAL_TIM_PeriodElapsedCallback(htim);
+    }
+}
+
+/* All IRQs share priority 0, so they run one at a time in vector order */
+void Host_DispatchInterrupts(void)
+{
+    extern TIM_HandleTypeDef htim3, htim16;
+
+    if (inInterrupt || hostPrimask || flashBusy || !booted) return;
+
+    if (sysTickPending) {
+        sysTickPending = 0;
+        uwTick += uwTickFreq;
+    }
+
+    inInterrupt = 1;
+    while (Host_InterruptPending()) {
+        if (extiPending) {
+            extiPending = 0;
+            HAL_GPIO_EXTI_Callback(GPIO_PIN_0);
+        } else if (dmaHalfPending) {
+            dmaHalfPending = 0;
+            HAL_TIM_PWM_PulseFinishedHalfCpltCallback(&htim3);
+        } else if (dmaCompletePending) {
+            dmaCompletePending = 0;
+            HAL_TIM_PWM_PulseFinishedCallback(&htim3);
+        } else if (Host_TimerPending(TIM3)) {
+            Host_TimerInterrupt(&htim3);
+        } else {
+            Host_TimerInterrupt(&htim16);
+        }
+    }
+    inInterrupt = 0;
+}
+
+/* Coroutine -----------------------------------------------------------------*/
+
+static void Host_Yield(void)
+{
+    swapcontext(&firmwareContext, &hostContext);
+}
+
+static void Host_FirmwareEntry(void)
+{
+    Firmware_Main();
+    fprintf(stderr, "host: firmware main returned\n");
+    exit(1);
+}
+
+void Host_Boot(void)
+{
+    getcontext(&firmwareContext);
+    firmwareContext.uc_stack.ss_sp = malloc(HOST_STACK_SIZE);
+    firmwareContext.uc_stack.ss_size = HOST_STACK_SIZE;
+    firmwareContext.uc_link = NULL;
+    makecontext(&firmwareContext, Host_FirmwareEntry, 0);
+    booted = 1;
+}
+
+/* Let the firmware run until it is idle at or after untilUs */
+void Host_Run(uint32_t untilUs)
+{
+    limitUs = untilUs;
+    swapcontext(&hostContext, &firmwareContext);
+}
+
+uint32_t Host_Micros(void)
+{
+    return (uint32_t)nowUs;
+}
+
+/* PA0 level, both edges raise EXTI0 */
+void Host_SetButton(uint8_t pressed)
+{
+    uint32_t level = pressed ? GPIO_PIN_0 : 0;
+
+    if ((GPIOA->IDR & GPIO_PIN_0) != level) {
+        GPIOA->IDR = (GPIOA->IDR & ~GPIO_PIN_0) | level;
+        extiPending = 1;
+    }
+}
+
+/* Park the core until an interrupt is pending, handing back to the host
+ * whenever the time it allowed has run out */
+static void Host_WaitForInterrupt(void)
+{
+    while (!Host_InterruptPending()) {
+        if (nowUs >= limitUs) {
+            Host_Yield();
+        } else {
+            Host_Tick();
+        }
+    }
+}
+
+/* HAL -----------------------------------------------------------------------*/
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+    return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+    for (uint8_t i = 0; i < HOST_GETTICK_COST_US; i++) {
+        Host_Tick();
+    }
+    if (nowUs >= limitUs && !inInterrupt) {
+        Host_Yield();
+    }
+    Host_DispatchInterrupts();
+    return uwTick;
+}
+
+void HAL_Delay(uint32_t Delay)
+{
+    uint32_t tickstart = HAL_GetTick();
+
+    while ((HAL_GetTick() - tickstart) < Delay + uwTickFreq) {
+    }
+}
+
+void HAL_SuspendTick(void)
+{
+    tickSuspended = 1;
+}
+
+void HAL_ResumeTick(void)
+{
+    tickSuspended = 0;
+}
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry)
+{
+    (void)Regulator;
+    (void)SLEEPEntry;
+    Host_WaitForInterrupt();
+}
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry)
+{
+    (void)Regulator;
+    (void)STOPEntry;
+    stopMode = 1;
+    Host_WaitForInterrupt();
+    stopMode = 0;
+}
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+    (void)RCC_OscInitStruct;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+    (void)RCC_ClkInitStruct;
+    (void)FLatency;
+    return HAL_OK;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+    (void)IRQn;
+    (void)PreemptPriority;
+    (void)SubPriority;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+    (void)IRQn;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+    return (GPIOx->IDR & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    return HAL_OK;
+}
+
+/* Includes what HAL_TIM_Base_MspInit does for TIM3: link DMA1_Channel4 */
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->PSC = htim->Init.Prescaler;
+    htim->Instance->ARR = htim->Init.Period;
+    htim->Instance->CNT = 0;
+
+    if (htim->Instance == TIM3) {
+        hdma_tim3_ch1_trig.Instance = DMA1_Channel4;
+        hdma_tim3_ch1_trig.Init.Mode = DMA_NORMAL;
+        tim3ActiveArr = htim->Init.Period;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+    (void)htim;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, TIM_ClockConfigTypeDef *sClockSourceConfig)
+{
+    (void)htim;
+    (void)sClockSourceConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, TIM_MasterConfigTypeDef *sMasterConfig)
+{
+    (void)htim;
+    (void)sMasterConfig;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, TIM_OC_InitTypeDef *sConfig, uint32_t Channel)
+{
+    (void)Channel;
+    htim->Instance->CCR1 = sConfig->Pulse;
+    return HAL_OK;
+}
+
+void HAL_TIM_MspPostInit(TIM_HandleTypeDef *htim)
+{
+    (void)htim;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->CR1 |= 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim)
+{
+    htim->Instance->DIER |= TIM_DIER_UIE;
+    htim->Instance->CR1 |= 1;
+    return HAL_OK;
+}
+
+/* Starts the capture of a new frame on the data line */
+HAL_StatusTypeDef HAL_TIM_PWM_Start_DMA(TIM_HandleTypeDef *htim, uint32_t Channel, const uint32_t *pData, uint16_t Length)
+{
+    (void)Channel;
+    if (htim->Instance != TIM3 || pData == NULL || Length == 0) return HAL_ERROR;
+
+    Host_EndFrame();
+    if (submitHook != NULL) {
+        submitHook();
+    }
+
+    // The frame opens with the time the line has already been low: the reset
+    // the LEDs saw between the previous frame and this one
+    uint64_t idle = nowUs * HOST_HCLK_PER_US - lineFallClock;
+    capture[0].high = 0;
+    capture[0].period = (idle > UINT32_MAX) ? UINT32_MAX : (uint32_t)idle;
+    captureCount = 1;
+    capturing = 1;
+
+    dmaSource = (const uint8_t *)pData;
+    dmaLength = Length;
+    dmaIndex = 0;
+    dmaActive = 1;
+    dmaCircular = (hdma_tim3_ch1_trig.Init.Mode == DMA_CIRCULAR);
+    DMA1_Channel4->CNDTR = Length;
+
+    TIM3->DIER |= TIM_DIER_CC1DE;
+    TIM3->CR1 |= 1;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+    (void)Channel;
+    if (htim->Instance != TIM3) return HAL_ERROR;
+
+    TIM3->DIER &= ~TIM_DIER_CC1DE;
+    TIM3->CR1 &= ~1U;
+    dmaActive = 0;
+    dmaHalfPending = 0;
+    dmaCompletePending = 0;
+    Host_EndFrame();
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+    FLASH->AR = 0;
+    FLASH->SR = 0;
+    return HAL_OK;
+}
+
+/* The operation itself already happened on the RAM page, this adds the time
+ * the core would have spent stalled on it */
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+    if (FLASH->SR & FLASH_SR_EOP) {
+        uint32_t stallUs = HOST_FLASH_WORD_US;
+
+        if (FLASH->AR != 0) {
+            memset(Host_Flash(FLASH->AR & ~0x3FFU), 0xFF, 0x400);
+            flashStats.erases++;
+            stallUs = HOST_FLASH_ERASE_US;
+        } else {
+            flashStats.words++;
+        }
+
+        flashBusy = 1;
+        while (stallUs--) {
+            Host_Tick();
+        }
+        flashBusy = 0;
+    }
+
+    FLASH->AR = 0;
+    FLASH->SR = 0;
+    return HAL_OK;
+}
@@ -0,0 +1,176 @@
+/**
+******************************************************************************
+* @file           : host_main.c
+* @brief          : boots the firmware on the host and walks it through every mode
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "host.h"
+#include "ws2812b.h"
+#include "flash_storage.h"
+#include "frame_scheduler.h"
+#include "telemetry.h"
+#include "button.h"
+#include "low_power.h"
+#include <stdio.h>
+
+#define HOST_MS(ms)     ((uint32_t)(ms) * 1000U)
+
+static uint32_t frames = 0;
+static uint32_t inputUs = 0;        // When the last press should start showing, 0 = it does
+static uint32_t latencyUs = 0;      // From there to the DMA start of the first frame
+
+/* The virtual clock does not move while firmware code runs, so latency here
+ * is scheduling only: how long the firmware waits for the slot, the wire or
+ * the flash before the frame starts. Render and encode time come on top on
+ * the board; the input column of the telemetry (inputMaxUs) has the real
+ * worst case per effect. */
+
+static void OnFrame(const host_pulse_t *pulses, uint32_t count)
+{
+    (void)pulses;
+    (void)count;
+    frames++;
+}
+
+static void OnSubmit(void)
+{
+    if (inputUs != 0) {
+        latencyUs = Host_Micros() - inputUs;
+        inputUs = 0;
+    }
+}
+
+/* Hold PA0 for holdMs, then let the firmware run for runMs. The press takes
+ * effect on release, or at the threshold for a long press. */
+static void Press(uint32_t holdMs, uint32_t runMs)
+{
+    uint32_t start = Host_Micros();
+
+    latencyUs = 0;
+    Host_SetButton(1);
+    if (holdMs >= LONG_PRESS_TIME_MS) {
+        Host_Run(start + HOST_MS(LONG_PRESS_TIME_MS));
+        inputUs = Host_Micros();
+    }
+    Host_Run(start + HOST_MS(holdMs));
+    Host_SetButton(0);
+    if (holdMs < LONG_PRESS_TIME_MS) {
+        inputUs = Host_Micros();
+    }
+    Host_Run(Host_Micros() + HOST_MS(runMs));
+}
+
+static void Report(const char *what)
+{
+    const frame_scheduler_stats_t *sched = Frame_Scheduler_GetStats();
+    const ws2812b_transport_stats_t *wire = WS2812B_GetTransportStats();
+
+    printf("%-12s t=%6lums sched latency=%5luus frames=%3lu sent=%4lu skipped=%3lu dropped=%lu period=%6luus interval=%lu..%luus overruns=%lu\n",
+           what, (unsigned long)(Host_Micros() / 1000), (unsigned long)latencyUs, (unsigned long)frames,
+           (unsigned long)wire->framesSent, (unsigned long)wire->framesSkipped, (unsigned long)wire->framesDropped,
+           (unsigned long)sched->periodUs,
+           (unsigned long)(sched->frames > 1 ? sched->intervalMinUs : 0),
+           (unsigned long)sched->intervalMaxUs, (unsigned long)sched->overruns);
+    frames = 0;
+}
+
+/* Usage: wradio_host [telemetry.bin], the file gets the telemetry block
+ * as a debugger would dump it, see telemetry.py */
+int main(int argc, char **argv)
+{
+    (void)argc;
+    (void)argv;
+
+    Host_SetFrameHook(OnFrame);
+    Host_SetSubmitHook(OnSubmit);
+    Host_Boot();
+
+    Host_Run(HOST_MS(1000));
+    Report("boot");
+
+    // Short presses step through every effect and back to the static logo
+    for (uint8_t mode = 1; mode <= MODE_COUNT; mode++) {
+        Press(300, 2000);
+        Report(mode < MODE_COUNT ? "short press" : "wrapped");
+    }
+
+    // Long press steps the brightness, the save follows SAVE_DELAY_MS later
+    Press(1200, 4000);
+    Report("long press");
+
+    // Held until the save is done, so the release drops the core straight
+    // into Stop with the debounce window still open. TIM16 does not count in
+    // Stop: the tap after it must not be taken for bounce of that release.
+    uint32_t stops = Low_Power_GetStats()->stopCount;
+    Press(3500, 1000);
+    Report("held past save");
+    Press(40, 2000);
+    Report("tap after stop");
+    if (Low_Power_GetStats()->stopCount == stops || Frame_Scheduler_GetStats()->periodUs == 0) {
+        fprintf(stderr, "press after Stop mode was lost\n");
+        return 1;
+    }
+
+    // The same in an animated effect: shown at once, the frame slots and
+    // the animation phase carry on
+    Press(300, 2000);
+    Report("short press");
+    for (uint8_t i = 0; i < 2; i++) {
+        Press(1200, 2000);
+        Report("long press");
+    }
+
+    // A short press that wakes the core from Stop: the wake-up happens at the
+    // press edge, the latency runs from the release like any other press
+    for (uint8_t mode = 0; mode < MODE_COUNT && Frame_Scheduler_GetStats()->periodUs != 0; mode++) {
+        Press(300, 500);
+    }
+    Report("wrapped");
+    stops = Low_Power_GetStats()->stopCount;
+    Press(3500, 1000);
+    Report("held past save");
+    Press(300, 2000);
+    Report("press after stop");
+    if (Low_Power_GetStats()->stopCount == stops || Frame_Scheduler_GetStats()->periodUs == 0) {
+        fprintf(stderr, "press after Stop mode was lost\n");
+        return 1;
+    }
+
+    const flash_settings_t *settings = Flash_Storage_GetSettings();
+    const host_flash_stats_t *flash = Host_GetFlashStats();
+    printf("settings: mode=%u brightness=%u, flash erases=%lu words=%lu, longest stall=%luus\n",
+           settings->mode, settings->brightnessLevel, (unsigned long)flash->erases,
+           (unsigned long)flash->words, (unsigned long)Flash_Storage_GetLongestStall());
+
+#if TELEMETRY_ENABLED
+    if (argc > 1) {
+        FILE *dump = fopen(argv[1], "wb");
+        if (dump == NULL || fwrite(&telemetry, sizeof(telemetry), 1, dump) != 1) {
+            perror(argv[1]);
+            return 1;
+        }
+        fclose(dump);
+    }
+#else
+    if (argc > 1) {
+        fprintf(stderr, "%s: built without TELEMETRY_ENABLED, no block to dump\n", argv[1]);
+        return 1;
+    }
+#endif
+
+    return 0;
+}
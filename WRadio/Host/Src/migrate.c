@@ -0,0 +1,129 @@
+/**
+******************************************************************************
+* @file           : migrate.c
+* @brief          : boots the firmware on settings pages written by older firmware
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "host.h"
+#include "flash_storage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Each case writes a settings page byte for byte as the older firmware left
+ * it on the target, boots a fresh process on it and checks the settings the
+ * firmware restored. The images are bytes, not structs: the host's enums are
+ * 4 bytes, the target's are 1 (short enums), so a struct built here would
+ * not have the target layout. */
+#define MIGRATE_BOOT_US     200000  // Past the power-up delay in main()
+#define MIGRATE_MAX_BYTES   48
+
+typedef struct {
+    const char *name;
+    uint8_t image[MIGRATE_MAX_BYTES];   // Start of the page, the rest stays erased
+    uint8_t size;
+    uint8_t mode;                       // Expected after boot
+    uint8_t brightnessLevel;
+} migrate_case_t;
+
+/* Version 1, the original flash_settings_t: magic 0xDEADBEEF, mode and
+ * brightness as bytes 4 and 5, 6 reserved bytes, word 3 the XOR of words 0
+ * to 2. Version 2 log records (magic 0x5E77106A, sequence, mode | brightness
+ * | erase count, XOR of words 0 to 2) follow it in the next 16-byte slot.
+ * Version 3 records are 5 words: magic 0x5E7C | version | words, sequence,
+ * erase count, mode | brightness, CRC-32 of words 0 to 3. */
+static const migrate_case_t cases[] = {
+    {
+        .name = "v1",
+        .image = { 0xEF, 0xBE, 0xAD, 0xDE,  0x05, 0x03, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0xEA, 0xBD, 0xAD, 0xDE },
+        .size = 16, .mode = MODE_RAINBOW, .brightnessLevel = 3,
+    },
+    {
+        .name = "v1 bad xor",
+        .image = { 0xEF, 0xBE, 0xAD, 0xDE,  0x05, 0x03, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0xEF, 0xBE, 0xAD, 0xDE },
+        .size = 16, .mode = MODE_STATIC_LOGO, .brightnessLevel = 2,
+    },
+    {
+        .name = "v1 + v2 log",
+        .image = { 0xEF, 0xBE, 0xAD, 0xDE,  0x05, 0x03, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0xEA, 0xBD, 0xAD, 0xDE,
+                   0x6A, 0x10, 0x77, 0x5E,  0x01, 0x00, 0x00, 0x00,
+                   0x07, 0x01, 0x00, 0x00,  0x6C, 0x11, 0x77, 0x5E },
+        .size = 32, .mode = MODE_FILL, .brightnessLevel = 1,
+    },
+    {
+        .name = "v3",
+        .image = { 0x7C, 0x5E, 0x03, 0x05,  0x01, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0x06, 0x04, 0x00, 0x00,
+                   0xE5, 0x7A, 0x26, 0x88 },
+        .size = 20, .mode = MODE_COMET, .brightnessLevel = 4,
+    },
+    {
+        // Newer sequence, right length and CRC, but a version this firmware
+        // does not know: the v3 record before it stays current
+        .name = "v3 + unknown",
+        .image = { 0x7C, 0x5E, 0x03, 0x05,  0x01, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0x06, 0x04, 0x00, 0x00,
+                   0xE5, 0x7A, 0x26, 0x88,
+                   0x7C, 0x5E, 0x04, 0x05,  0x02, 0x00, 0x00, 0x00,
+                   0x00, 0x00, 0x00, 0x00,  0x03, 0x00, 0x00, 0x00,
+                   0x0A, 0x4E, 0xAA, 0xD2 },
+        .size = 40, .mode = MODE_COMET, .brightnessLevel = 4,
+    },
+};
+
+/* Child process: boot on the image, exit 0 if the settings came back */
+static int Migrate_Run(const migrate_case_t *test)
+{
+    memcpy(Host_Flash(FLASH_STORAGE_PAGE_ADDR), test->image, test->size);
+    Host_Boot();
+    Host_Run(MIGRATE_BOOT_US);
+
+    const flash_settings_t *settings = Flash_Storage_GetSettings();
+    if (settings->mode != test->mode || settings->brightnessLevel != test->brightnessLevel) {
+        printf("%-12s mode=%u brightness=%u, expected %u and %u\n", test->name, settings->mode,
+               settings->brightnessLevel, test->mode, test->brightnessLevel);
+        return 1;
+    }
+    printf("%-12s ok\n", test->name);
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t failed = 0;
+
+    for (uint8_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        // Firmware state is static, a fresh process per case starts from reset
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) {
+            exit(Migrate_Run(&cases[i]));
+        }
+
+        int status;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = 1;
+        }
+    }
+    return failed;
+}
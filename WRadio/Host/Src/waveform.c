@@ -0,0 +1,251 @@
+/**
+******************************************************************************
+* @file           : waveform.c
+* @brief          : decodes the captured WS2812B data line and checks it against the datasheet
+******************************************************************************
+*
+* ██████╗ ███████╗ ██████╗████████╗██████╗  ██████╗ ███╗   ██╗██╗ ██████╗███████╗
+* ██╔══██╗██╔════╝██╔════╝╚══██╔══╝██╔══██╗██╔═══██╗████╗  ██║██║██╔════╝██╔════╝
+* ██║  ██║█████╗  ██║        ██║   ██████╔╝██║   ██║██╔██╗ ██║██║██║     ███████╗
+* ██║  ██║██╔══╝  ██║        ██║   ██╔══██╗██║   ██║██║╚██╗██║██║██║     ╚════██║
+* ██████╔╝███████╗╚██████╗   ██║   ██║  ██║╚██████╔╝██║ ╚████║██║╚██████╗███████║
+* ╚═════╝ ╚══════╝ ╚═════╝   ╚═╝   ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝ ╚═════╝╚══════╝
+*
+******************************************************************************
+* @author         : Tiebe Declercq
+* @copyright      : Copyright (c) 2025 DECTRONICS. All rights reserved.
+* @version        : 1.0.0
+* @date           : 2026-10-17
+******************************************************************************
+*/
+#include "host.h"
+#include "ws2812b.h"
+#include "fixed_math.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* WS2812B datasheet timing in ns: T0H 0.4 us, T1H 0.8 us, T0L 0.85 us,
+ * T1L 0.45 us, each +-150 ns, a bit 1.25 us +-600 ns, reset above 50 us.
+ * Newer parts (WS2812B-V5) need a reset of 280 us, reported separately. */
+#define WAVE_T0H_MIN        250
+#define WAVE_T0H_MAX        550
+#define WAVE_T1H_MIN        650
+#define WAVE_T1H_MAX        950
+#define WAVE_T0L_MIN        700
+#define WAVE_T0L_MAX        1000
+#define WAVE_T1L_MIN        300
+#define WAVE_T1L_MAX        600
+#define WAVE_PERIOD_MIN     650
+#define WAVE_PERIOD_MAX     1850
+#define WAVE_RESET_MIN      50000
+#define WAVE_RESET_V5_MIN   280000
+#define WAVE_BIT_THRESHOLD  600         // High time separating a 0 from a 1
+
+#define WAVE_FRAMES         32          // Frames checked per effect
+#define WAVE_RUN_US         10000000    // Unless the effect sends fewer in this time
+#define WAVE_BRIGHTNESS_LEVEL 2
+
+#define WAVE_NS(clocks)     ((uint32_t)(((uint64_t)(clocks) * 1000) / HOST_HCLK_PER_US))
+
+#if WS2812B_STREAMING
+extern uint32_t *currentColors;
+#else
+extern uint32_t currentColors[LED_COUNT];
+#endif
+
+typedef struct {
+    uint32_t min;
+    uint32_t max;
+} wave_range_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t violations;
+    uint32_t mismatches;
+    wave_range_t t0h, t1h, t0l, t1l, period;
+    uint32_t resetMin;
+} wave_stats_t;
+
+static wave_stats_t stats;
+
+static void Wave_Range(wave_range_t *range, uint32_t value)
+{
+    if (value < range->min) range->min = value;
+    if (value > range->max) range->max = value;
+}
+
+static void Wave_Violation(uint32_t frame, const char *what, uint32_t index, uint32_t value)
+{
+    if (stats.violations++ == 0) {
+        printf("  frame %lu, bit %lu: %s %lu ns\n", (unsigned long)frame, (unsigned long)index, what,
+               (unsigned long)value);
+    }
+}
+
+static void Wave_Check(uint32_t frame, const char *what, uint32_t index, uint32_t value,
+                       uint32_t min, uint32_t max)
+{
+    if (value < min || value > max) {
+        Wave_Violation(frame, what, index, value);
+    }
+}
+
+static uint32_t expected[LED_COUNT];
+
+/* Submit hook: what the encoder should be putting on the wire. Taken when
+ * the DMA starts, the effects render the next frame while this one is sent. */
+static void Wave_OnSubmit(void)
+{
+    uint8_t scale = Fixed_Math_Scale8(255, globalBrightness);
+
+    for (uint16_t i = 0; i < LED_COUNT; i++) {
+        expected[i] = Fixed_Math_ScaleColor(currentColors[i], scale);
+    }
+}
+
+/* A dithered channel may be one step above the truncated value */
+static uint8_t Wave_Matches(uint32_t sent, uint32_t want)
+{
+#if WS2812B_DITHER
+    for (int8_t shift = 16; shift >= 0; shift -= 8) {
+        uint8_t diff = ((sent >> shift) & 0xFF) - ((want >> shift) & 0xFF);
+        if (diff > 1) return 0;
+    }
+    return 1;
+#else
+    return sent == want;
+#endif
+}
+
+/* Frame hook: decode the pulses back into pixels and time every bit */
+static void Wave_OnFrame(const host_pulse_t *pulses, uint32_t count)
+{
+    uint32_t frame = stats.frames++;
+    uint32_t bits = 0;
+    uint32_t grb = 0;
+    uint8_t dataEnded = 0;
+
+    if (count > 0 && pulses[0].high == 0) {
+        uint32_t reset = WAVE_NS(pulses[0].period);
+        if (reset < stats.resetMin) stats.resetMin = reset;
+        Wave_Check(frame, "reset", 0, reset, WAVE_RESET_MIN, UINT32_MAX);
+    }
+
+    for (uint32_t i = 1; i < count; i++) {
+        if (pulses[i].high == 0) {
+            dataEnded = (bits > 0);
+            continue;
+        }
+        if (dataEnded) {
+            Wave_Violation(frame, "line low inside the frame, for", bits, WAVE_NS(pulses[i - 1].period));
+            dataEnded = 0;
+        }
+
+        uint32_t high = WAVE_NS(pulses[i].high);
+        uint32_t low = WAVE_NS(pulses[i].period - pulses[i].high);
+        uint32_t period = WAVE_NS(pulses[i].period);
+        uint8_t bit = (high >= WAVE_BIT_THRESHOLD);
+
+        if (bit) {
+            Wave_Range(&stats.t1h, high);
+            Wave_Range(&stats.t1l, low);
+            Wave_Check(frame, "T1H", bits, high, WAVE_T1H_MIN, WAVE_T1H_MAX);
+            Wave_Check(frame, "T1L", bits, low, WAVE_T1L_MIN, WAVE_T1L_MAX);
+        } else {
+            Wave_Range(&stats.t0h, high);
+            Wave_Range(&stats.t0l, low);
+            Wave_Check(frame, "T0H", bits, high, WAVE_T0H_MIN, WAVE_T0H_MAX);
+            Wave_Check(frame, "T0L", bits, low, WAVE_T0L_MIN, WAVE_T0L_MAX);
+        }
+        Wave_Range(&stats.period, period);
+        Wave_Check(frame, "bit period", bits, period, WAVE_PERIOD_MIN, WAVE_PERIOD_MAX);
+
+        grb = (grb << 1) | bit;
+        if (++bits % 24 == 0) {
+            uint16_t pixel = bits / 24 - 1;
+            uint32_t color = ((grb & 0x00FF00) << 8) | ((grb & 0xFF0000) >> 8) | (grb & 0xFF);
+
+            if (pixel < LED_COUNT && !Wave_Matches(color, expected[pixel]) && stats.mismatches++ == 0) {
+                printf("  frame %lu, pixel %u: sent %06lX, expected %06lX\n", (unsigned long)frame, pixel,
+                       (unsigned long)color, (unsigned long)expected[pixel]);
+            }
+        }
+    }
+
+    if (bits != LED_COUNT * 24) {
+        Wave_Violation(frame, "bit count, not the chain length, got", bits, bits);
+    }
+}
+
+static void Wave_Print(const char *name, const wave_range_t *range)
+{
+    if (range->min > range->max) {
+        printf(" %s -", name);
+    } else if (range->min == range->max) {
+        printf(" %s %lu", name, (unsigned long)range->min);
+    } else {
+        printf(" %s %lu..%lu", name, (unsigned long)range->min, (unsigned long)range->max);
+    }
+}
+
+/* Child process: boot into mode and check the frames it sends */
+static int Wave_Verify(effect_mode_t mode)
+{
+    const wave_range_t empty = { UINT32_MAX, 0 };
+
+    memset(&stats, 0, sizeof(stats));
+    stats.t0h = stats.t1h = stats.t0l = stats.t1l = stats.period = empty;
+    stats.resetMin = UINT32_MAX;
+
+    Host_StoreSettings(mode, WAVE_BRIGHTNESS_LEVEL);
+    Host_SetFrameHook(Wave_OnFrame);
+    Host_SetSubmitHook(Wave_OnSubmit);
+    Host_Boot();
+    while (stats.frames < WAVE_FRAMES && Host_Micros() < WAVE_RUN_US) {
+        Host_Run(Host_Micros() + 1000);
+    }
+
+    printf("mode %-2u frames %-3lu ns:", mode, (unsigned long)stats.frames);
+    Wave_Print("T0H", &stats.t0h);
+    Wave_Print("T0L", &stats.t0l);
+    Wave_Print("T1H", &stats.t1h);
+    Wave_Print("T1L", &stats.t1l);
+    Wave_Print("bit", &stats.period);
+    printf(" reset>=%lu.%luus%s", (unsigned long)(stats.resetMin / 1000),
+           (unsigned long)(stats.resetMin % 1000 / 100),
+           (stats.resetMin < WAVE_RESET_V5_MIN) ? " (short for V5)" : "");
+
+    if (stats.violations || stats.mismatches) {
+        printf(" FAILED: %lu timing, %lu pixel errors\n", (unsigned long)stats.violations,
+               (unsigned long)stats.mismatches);
+        return 1;
+    }
+    printf(" ok\n");
+    return 0;
+}
+
+int main(void)
+{
+    uint8_t failed = 0;
+
+    printf("WS2812B on %u LEDs, %s transport, TIM3 at %u MHz\n", LED_COUNT,
+           WS2812B_STREAMING ? "streaming" : "buffered", HOST_HCLK_PER_US);
+
+    for (uint8_t mode = MODE_STATIC_LOGO; mode < MODE_COUNT; mode++) {
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) {
+            exit(Wave_Verify(mode));
+        }
+
+        int status;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed = 1;
+        }
+    }
+
+    return failed;
+}
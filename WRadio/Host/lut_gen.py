@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Generate the lookup tables of Core/Src/lut_tables.c (declared in
+Core/Inc/lut.h).
+
+The CubeIDE build cannot run a generator, so the output is checked in. After
+changing this script, rewrite it from the host directory with `make lut`;
+`make lut-check` fails while the checked-in file differs from the output:
+
+    python3 lut_gen.py ../Core/Src/lut_tables.c
+
+Every table is const and lives in flash, its size is printed to stderr so the
+cost shows up next to the 15 KB .text budget.
+"""
+import math
+import sys
+
+GAMMA = 2.2         # gamma8: perceived brightness to LED duty
+SIN8_QUARTER = 64   # sin8: entries per quarter wave, plus the peak
+HUE_SECTOR = 85     # hue8: steps from one primary to the next, plus the end
+
+BANNER = """/**
+******************************************************************************
+* @file           : lut_tables.c
+* @brief          : sine, gamma and hue lookup tables, generated by
+*                   Host/lut_gen.py: do not edit, change the script
+******************************************************************************
+*/
+#include "lut.h"
+"""
+
+
+def sin8_quarter():
+    # First quarter of 127 * sin, Lut_Sin8 mirrors it into the full wave
+    return [round(127 * math.sin(math.pi / 2 * i / SIN8_QUARTER)) for i in range(SIN8_QUARTER + 1)]
+
+
+def gamma8():
+    return [round(255 * (i / 255) ** GAMMA) for i in range(256)]
+
+
+def hue8_ramp():
+    # sin^2 crossfade: two neighbouring primaries still add up to 255, but the
+    # hue eases in and out of each primary instead of turning a corner there
+    return [round(255 * math.sin(math.pi / 2 * i / HUE_SECTOR) ** 2) for i in range(HUE_SECTOR + 1)]
+
+
+def table(name, size_macro, comment, values):
+    lines = ["", "/* %s */" % comment, "const uint8_t %s[%s] = {" % (name, size_macro)]
+    for start in range(0, len(values), 16):
+        lines.append("    " + ", ".join("%3d" % v for v in values[start:start + 16]) + ",")
+    lines.append("};")
+    return lines, len(values)
+
+
+def main():
+    tables = (
+        ("lutSin8Quarter", "LUT_SIN8_QUARTER + 1", "127 * sin, first quarter wave", sin8_quarter()),
+        ("lutGamma8", "256", "Gamma %.1f" % GAMMA, gamma8()),
+        ("lutHue8Ramp", "LUT_HUE_SECTOR + 1", "Rising edge of one hue sector, sin^2 crossfade", hue8_ramp()),
+    )
+    out = BANNER.splitlines()
+    total = 0
+    for name, size_macro, comment, values in tables:
+        lines, size = table(name, size_macro, comment, values)
+        out += lines
+        total += size
+        print("%-16s %4d bytes flash" % (name, size), file=sys.stderr)
+    print("%-16s %4d bytes flash" % ("total", total), file=sys.stderr)
+
+    text = "\n".join(out) + "\n"
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
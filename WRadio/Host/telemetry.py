@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Decode the WRadio telemetry block (telemetry_t, Core/Inc/telemetry.h) from a
+memory dump.
+
+The block lives at TELEMETRY_ADDRESS (0x20000000) and can be read over SWD
+while the firmware runs, for example with OpenOCD:
+
+    openocd -f interface/stlink.cfg -f target/stm32f0x.cfg \\
+        -c "init; dump_image telemetry.bin 0x20000000 256; exit"
+
+    python3 telemetry.py telemetry.bin
+
+A dump of the whole RAM works too, pass --base with the address the dump
+starts at. Keep the layout below in step with telemetry_t and
+TELEMETRY_VERSION.
+"""
+import argparse
+import struct
+import sys
+
+TELEMETRY_ADDRESS = 0x20000000
+TELEMETRY_MAGIC = 0x4D4C5457
+TELEMETRY_VERSION = 2
+
+HEADER = struct.Struct("<IHHIIBBHHH9I")
+EFFECT = struct.Struct("<7H")
+# sizeof(telemetry_t): the effects array ends on a halfword, the struct on a word
+BLOCK_SIZE = (HEADER.size + EFFECT.size * 11 + 3) & ~3
+
+HEADER_FIELDS = (
+    "magic", "version", "size", "sequence", "uptimeMs", "mode", "reserved",
+    "cpuLoadPermille", "cpuLoadMaxPermille", "reserved2",
+    "framesRendered", "framesSent", "framesSkipped", "framesDropped", "timeouts",
+    "flashSaves", "flashErases", "flashStallMaxUs", "flashStallTotalUs",
+)
+
+# effect_mode_t order
+EFFECTS = (
+    "static_logo", "breathe", "sparkle", "wave", "pulse", "rainbow",
+    "comet", "fill", "scanner", "color_shift", "strobe",
+)
+
+
+def decode(data):
+    if len(data) < HEADER.size:
+        raise ValueError("dump is shorter than the telemetry header")
+
+    block = dict(zip(HEADER_FIELDS, HEADER.unpack_from(data)))
+    if block["magic"] != TELEMETRY_MAGIC:
+        raise ValueError("no telemetry block here (magic 0x%08x)" % block["magic"])
+    if block["version"] != TELEMETRY_VERSION:
+        raise ValueError("telemetry version %d, this script reads %d" % (block["version"], TELEMETRY_VERSION))
+    if block["size"] != BLOCK_SIZE or len(data) < block["size"]:
+        raise ValueError("telemetry block is %d bytes, expected %d" % (block["size"], BLOCK_SIZE))
+
+    block["effects"] = [EFFECT.unpack_from(data, HEADER.size + i * EFFECT.size) for i in range(len(EFFECTS))]
+    return block
+
+
+def report(block):
+    mode = EFFECTS[block["mode"]] if block["mode"] < len(EFFECTS) else str(block["mode"])
+    if block["sequence"] & 1:
+        print("warning: dumped while the firmware was updating the block, read it again")
+
+    print("uptime      %.1f s, mode %s, update %d" % (block["uptimeMs"] / 1000.0, mode, block["sequence"] // 2))
+    print("cpu load    %.1f %% (max %.1f %%), Stop mode not counted"
+          % (block["cpuLoadPermille"] / 10.0, block["cpuLoadMaxPermille"] / 10.0))
+    print("frames      rendered %d, sent %d, skipped %d, dropped %d, timeouts %d"
+          % (block["framesRendered"], block["framesSent"], block["framesSkipped"],
+             block["framesDropped"], block["timeouts"]))
+    print("flash       saves %d, erases %d, stall max %d us, total %d us"
+          % (block["flashSaves"], block["flashErases"], block["flashStallMaxUs"], block["flashStallTotalUs"]))
+    print()
+    # Times saturate at 65535 us
+    print("%-12s %17s %17s %17s %9s" % ("us max/mean", "render", "encode", "dma", "input max"))
+    for name, times in zip(EFFECTS, block["effects"]):
+        if any(times):
+            print("%-12s %8d /%7d %8d /%7d %8d /%7d %9d" % ((name,) + times))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a WRadio telemetry dump")
+    parser.add_argument("dump", help="binary memory dump")
+    parser.add_argument("--base", type=lambda text: int(text, 0), default=TELEMETRY_ADDRESS,
+                        help="address the dump starts at (default 0x%08x)" % TELEMETRY_ADDRESS)
+    args = parser.parse_args()
+
+    offset = TELEMETRY_ADDRESS - args.base
+    with open(args.dump, "rb") as dump:
+        data = dump.read()
+    if offset < 0 or offset >= len(data):
+        sys.exit("the dump does not cover 0x%08x" % TELEMETRY_ADDRESS)
+
+    try:
+        report(decode(data[offset:]))
+    except ValueError as error:
+        sys.exit(str(error))
+
+
+if __name__ == "__main__":
+    main()